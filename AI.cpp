@@ -13,10 +13,48 @@
 #include <iostream>
 #include <windows.h>
 #include "AI.h"
+#include "EvalCache.h"
+#include "BatchEval.h"
+#include "Book.h"
+#include "Evaluator.h"
+#include "TransTable.h"
+#include "Pattern.h"
+#include "Trace.h"
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
 
 double minScore = -std::numeric_limits<double>::max();
 double maxScore = std::numeric_limits<double>::max();
 
+static thread_local EvalCache leaf_cache; //one per search thread, kept between moves
+static thread_local std::unique_ptr<EvalBatch> leaf_batch;
+//on larger boards Game::score() with the vectorized influence keeps up with
+//the batch, 13x13 is even and 19x19 is about 20% slower batched
+#define LEAF_BATCH_MAX_SIZE 11
+static TransTable *transposition = nullptr; //shared by every search thread
+static const PatternTable *move_patterns = nullptr;
+
+void set_transposition_table(TransTable *table) {
+	transposition = table;
+}
+
+void set_pattern_table(const PatternTable *table) {
+	move_patterns = table;
+}
+
+static void order_by_pattern(Game &input, std::vector<int> &moves) {
+	//heaviest pattern first, ties keep their order
+	const Board &board = input.get_board();
+	bool side = input.side();
+	std::stable_sort(moves.begin(), moves.end(),
+			[&board, side](int a, int b) {
+				return move_patterns->weight(board.get_pattern(a), side)
+						> move_patterns->weight(board.get_pattern(b), side);
+			});
+}
+
 double vertex_influence(int x, int y, uint8_t board_size) {
 	x = (x > 9) ? (board_size - x) : x;
 	y = (y > 9) ? (board_size - y) : y;
@@ -26,119 +64,523 @@ double vertex_influence(int x, int y, uint8_t board_size) {
 	return x_factor * y_factor;
 }
 
-double minimax(Game input, uint8_t depth, double alpha, double beta) {
-	if (depth <= 0) {
-		return input.score();
+//deadline and node budget of the search running on this thread
+struct SearchClock {
+	bool timed = false;
+	std::chrono::steady_clock::time_point deadline;
+	uint64_t max_nodes = 0;
+	uint64_t nodes = 0;
+	bool stopped = false;
+	bool searching = false; //inside search(), stats are published as it runs
+	std::chrono::steady_clock::time_point start;
+	SearchStats stats; //nodes and cache counts are filled in by running_stats()
+	uint64_t cache_probes = 0; //leaf cache counts when the search started
+	uint64_t cache_hits = 0;
+};
+static thread_local SearchClock search_clock;
+
+static SearchStats running_stats() {
+	SearchStats stats = search_clock.stats;
+	stats.nodes = search_clock.nodes;
+	stats.cache_probes = leaf_cache.get_probes() - search_clock.cache_probes;
+	stats.cache_hits = leaf_cache.get_hits() - search_clock.cache_hits;
+	stats.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - search_clock.start).count();
+	return stats;
+}
+
+static bool out_of_time() {
+	search_clock.nodes++;
+	if (search_clock.searching && (search_clock.nodes & 1023) == 0) {
+		thread_search_counters().publish(running_stats());
+	}
+	if (!search_clock.stopped && search_clock.timed
+			&& (search_clock.nodes & 63) == 0
+			&& std::chrono::steady_clock::now() >= search_clock.deadline) {
+		search_clock.stopped = true;
+	}
+	if (search_clock.max_nodes && search_clock.nodes >= search_clock.max_nodes) {
+		search_clock.stopped = true;
+	}
+	return search_clock.stopped;
+}
+
+//triangular principal variation table, the line below each ply of the
+//search running on this thread
+struct PrincipalVariation {
+	int ply = 0;
+	int length[MAX_PLY];
+	int moves[MAX_PLY][MAX_PLY];
+};
+static thread_local PrincipalVariation pv;
+
+static void pv_update(int move) {
+	//move followed by the line just found one ply further down
+	int ply = pv.ply;
+	if (ply >= MAX_PLY - 1) {
+		return;
+	}
+	int below = std::min(pv.length[ply + 1], MAX_PLY - 1);
+	pv.moves[ply][0] = move;
+	std::copy(pv.moves[ply + 1], pv.moves[ply + 1] + below, pv.moves[ply] + 1);
+	pv.length[ply] = below + 1;
+}
+
+static void pv_leaf(int move) {
+	if (pv.ply < MAX_PLY) {
+		pv.moves[pv.ply][0] = move;
+		pv.length[pv.ply] = 1;
+	}
+}
+
+static bool worth_playing(Game &input, int vertex) {
+	//nothing to gain inside a pass-alive area or in one of our own eyes
+	return !input.settled(vertex) && !input.is_eye(vertex, input.side());
+}
+
+//score weights of the search running on this thread, and a key for them
+//that is 0 for the defaults
+static thread_local ScoreWeights leaf_weights;
+static thread_local uint64_t leaf_weights_key = 0;
+
+static void set_leaf_weights(const ScoreWeights &weights) {
+	ScoreWeights defaults;
+	leaf_weights = weights;
+	leaf_weights_key = 0;
+	if (weights.influence != defaults.influence
+			|| weights.prisoners != defaults.prisoners) {
+		uint64_t bits[2];
+		memcpy(&bits[0], &weights.influence, sizeof(bits[0]));
+		memcpy(&bits[1], &weights.prisoners, sizeof(bits[1]));
+		leaf_weights_key = (bits[0] * 0xD6E8FEB86659FD93ull)
+				^ (bits[1] * 0x27BB2EE687B0B0FDull) ^ 1;
+	}
+}
+
+static uint64_t eval_key(Game &input) {
+	//score() is the same for all 8 symmetric boards, so they share an entry.
+	//it also depends on prisoners, which the board hash does not cover, and on
+	//the size: vertex indices alias between sizes and every empty board hashes
+	//to 0, while the cache lives on between searches of any size
+	return input.get_board().get_canonical_hash()
+			^ ((uint64_t) (input.get_prisoners() + 0x8000) * 0x9E3779B97F4A7C15ull)
+			^ (input.get_size() * 0x165667B19E3779F9ull) ^ leaf_weights_key;
+}
+
+static uint64_t search_key(Game &input, Evaluator *evaluator) {
+	//the exact board, so a stored move fits it, and everything else a
+	//searched score depends on
+	double komi = input.get_komi();
+	uint64_t komi_bits;
+	memcpy(&komi_bits, &komi, sizeof(komi_bits));
+	return input.zobristHash()
+			^ ((uint64_t) (input.get_prisoners() + 0x8000) * 0x9E3779B97F4A7C15ull)
+			^ (input.side() ? 0 : 0xC2B2AE3D27D4EB4Full)
+			^ (input.get_size() * 0x165667B19E3779F9ull)
+			^ ((komi_bits >> 32 | komi_bits << 32) * 0xD6E8FEB86659FD93ull)
+			^ (evaluator ? evaluator->identity() : leaf_weights_key);
+}
+
+double evaluate(Game &input) {
+	uint64_t key = eval_key(input);
+	double score;
+	search_clock.stats.leaf_evaluations++;
+	if (!leaf_cache.probe(key, score)) {
+		score = input.score(leaf_weights);
+		leaf_cache.store(key, score);
 	}
+	return score;
+}
+
+double best_leaf(Game &input, Evaluator *evaluator) {
 	int size = input.get_size();
-	int x_offset = rand() % size;
-	int y_offset = rand() % size;
-	double bestScore = input.side() ? minScore : maxScore;
-	if (input.side()) {
+	bool maximize = input.side();
+	double bestScore = maximize ? minScore : maxScore;
+	if (evaluator) {
+		static thread_local std::vector<Game> children;
+		static thread_local std::vector<int> moves;
+		static thread_local std::vector<Evaluation> evaluations;
+		children.clear();
+		moves.clear();
 		for (int i = 0; i < size; i++) {
 			for (int j = 0; j < size; j++) {
-				int move_x = (i + x_offset) % size;
-				int move_y = (j + y_offset) % size;
+				int vertex = input.get_vertex(i, j);
+				if (!worth_playing(input, vertex)) {
+					continue;
+				}
 				Game test = Game(input);
-				if (test.move(move_x, move_y)) {
-					double score = minimax(test, depth - 1, alpha, beta);
-					if (score > bestScore) {
-						bestScore = score;
-					}
-
-					if (bestScore > alpha) {
-						alpha = bestScore;
-					}
-
-					if (alpha >= beta) {
-						return bestScore;
-					}
+				if (test.move(vertex)) {
+					children.push_back(test);
+					moves.push_back(vertex);
 				}
 			}
 		}
-	} else {
-		for (int i = 0; i < size; i++) {
-			for (int j = 0; j < size; j++) {
-				int move_x = (i + x_offset) % size;
-				int move_y = (j + y_offset) % size;
-				Game test = Game(input);
-				if (test.move(move_x, move_y)) {
-					double score = minimax(test, depth - 1, alpha, beta);
-					if (score < bestScore) {
-						bestScore = score;
-					}
-
-					if (bestScore < beta) {
-						beta = bestScore;
-					}
-
-					if (alpha >= beta) {
-						return bestScore;
-					}
+		if (children.empty()) {
+			return minimax(input, 0, minScore, maxScore, evaluator); //only a pass is left
+		}
+		evaluations.resize(children.size());
+		search_clock.stats.leaf_evaluations += children.size();
+		evaluator->evaluate_batch(children.data(), children.size(),
+				evaluations.data());
+		for (size_t i = 0; i < evaluations.size(); i++) {
+			if (maximize ? evaluations[i].score > bestScore :
+							evaluations[i].score < bestScore) {
+				bestScore = evaluations[i].score;
+				pv_leaf(moves[i]);
+			}
+		}
+		return bestScore;
+	}
+
+	TRACE_SCOPE("best_leaf");
+	bool batched = size <= LEAF_BATCH_MAX_SIZE;
+	if (batched && (!leaf_batch || leaf_batch->get_boardsize() != size)) {
+		leaf_batch.reset(new EvalBatch(size, size * size)); //room for every child
+	}
+	if (batched) {
+		leaf_batch->clear();
+	}
+	static thread_local std::vector<uint64_t> pending;
+	static thread_local std::vector<int> pending_moves;
+	static thread_local std::vector<double> scores;
+	pending.clear();
+	pending_moves.clear();
+
+	for (int i = 0; i < size; i++) {
+		for (int j = 0; j < size; j++) {
+			int vertex = input.get_vertex(i, j);
+			if (!worth_playing(input, vertex)) {
+				continue;
+			}
+			Game test = Game(input);
+			if (test.move(vertex)) {
+				uint64_t key = eval_key(test);
+				double score;
+				search_clock.stats.leaf_evaluations++;
+				bool cached = leaf_cache.probe(key, score);
+				if (!cached && batched) {
+					leaf_batch->add(test);
+					pending.push_back(key);
+					pending_moves.push_back(vertex);
+					continue;
+				}
+				if (!cached) {
+					score = test.score(leaf_weights);
+					leaf_cache.store(key, score);
+				}
+				if (maximize ? score > bestScore : score < bestScore) {
+					bestScore = score;
+					pv_leaf(vertex);
 				}
 			}
 		}
 	}
 
+	if (pending.empty() && bestScore == (maximize ? minScore : maxScore)) {
+		return evaluate(input); //only a pass is left
+	}
+	if (pending.empty()) {
+		return bestScore;
+	}
+	scores.resize(pending.size());
+	leaf_batch->evaluate(scores.data(), leaf_weights);
+	for (size_t i = 0; i < pending.size(); i++) {
+		leaf_cache.store(pending[i], scores[i]);
+		if (maximize ? scores[i] > bestScore : scores[i] < bestScore) {
+			bestScore = scores[i];
+			pv_leaf(pending_moves[i]);
+		}
+	}
 	return bestScore;
 }
 
-int fuseki(Game input) {
-	int size = input.get_size();
-	int move_seq_0[] = { input.get_vertex(3, size - 4), input.get_vertex(size - 4,
-			3), input.get_vertex(size - 4, size - 4), input.get_vertex(3, 3),
-			input.get_vertex(size - 3, 5), input.get_vertex(size - 6, 2),
-			input.get_vertex(2, 2) };
-	Game x = Game(input.get_size());
-	for (int move : move_seq_0) {
-		if (input.zobristHash() == x.zobristHash()) {
-			return move;
+double minimax(Game input, uint8_t depth, double alpha, double beta,
+		Evaluator *evaluator) {
+	if (out_of_time()) {
+		return 0; //the caller throws away anything searched past the deadline
+	}
+	pv.length[std::min(pv.ply, MAX_PLY - 1)] = 0;
+	if (depth <= 0) {
+		if (evaluator) {
+			Evaluation evaluation;
+			evaluator->evaluate(input, evaluation);
+			search_clock.stats.leaf_evaluations++;
+			return evaluation.score;
+		}
+		return evaluate(input);
+	}
+	if (depth == 1) {
+		return best_leaf(input, evaluator); //all children scored in one batch
+	}
+	//a stored result can settle this node, or at least say what to try first
+	uint64_t key = 0;
+	int stored_move = Board::PASS;
+	double alpha_in = alpha, beta_in = beta;
+	if (transposition) {
+		key = search_key(input, evaluator);
+		TransTable::Result stored;
+		search_clock.stats.tt_probes++;
+		if (transposition->probe(key, stored)) {
+			search_clock.stats.tt_hits++;
+			stored_move = stored.move;
+			if (stored.depth >= depth) {
+				if (stored.bound == TransTable::EXACT) {
+					return stored.score;
+				} else if (stored.bound == TransTable::LOWER) {
+					alpha = std::max(alpha, stored.score);
+				} else {
+					beta = std::min(beta, stored.score);
+				}
+				if (alpha >= beta) {
+					return stored.score;
+				}
+			}
 		}
-		x.move(move);
 	}
-	return 0;
-}
 
-int bestMove(Game input, uint8_t depth) {
 	int size = input.get_size();
 	int x_offset = rand() % size;
 	int y_offset = rand() % size;
-	int bestX = rand() % size;
-	int bestY = rand() % size;
-	double bestScore = (input.side()) ? minScore : maxScore;
-	if (input.side()) {
+	bool maximize = input.side();
+	double bestScore = maximize ? minScore : maxScore;
+	int best_move = Board::PASS;
+	int tried = 0;
+	auto visit = [&](int vertex) { //true on a cutoff
+		if (!worth_playing(input, vertex)) {
+			return false;
+		}
+		Game test = Game(input);
+		if (!test.move(vertex)) {
+			return false;
+		}
+		tried++;
+		pv.ply++;
+		double score = minimax(test, depth - 1, alpha, beta, evaluator);
+		pv.ply--;
+		if (maximize ? score > bestScore : score < bestScore) {
+			bestScore = score;
+			best_move = vertex;
+			pv_update(vertex);
+		}
+		if (maximize) {
+			alpha = std::max(alpha, bestScore);
+		} else {
+			beta = std::min(beta, bestScore);
+		}
+		if (alpha < beta) {
+			return false;
+		}
+		search_clock.stats.cutoffs++;
+		if (tried == 1) {
+			search_clock.stats.first_move_cutoffs++; //the ordering got it right
+		}
+		return true;
+	};
+
+	bool cutoff = stored_move != Board::PASS
+			&& input.get_board().valid_vertex(stored_move) && visit(stored_move);
+	if (move_patterns) {
+		std::vector<int> moves;
 		for (int i = 0; i < size; i++) {
 			for (int j = 0; j < size; j++) {
-				int move_x = (i + x_offset) % size;
-				int move_y = (j + y_offset) % size;
-				Game test = Game(input);
-				if (test.move(move_x, move_y)) {
-					double score = minimax(test, depth - 1, minScore, maxScore);
-					if (score > bestScore) {
-						bestScore = score;
-						bestX = move_x;
-						bestY = move_y;
-					}
+				int vertex = input.get_vertex((i + x_offset) % size,
+						(j + y_offset) % size);
+				if (vertex != stored_move
+						&& input.get_board().get_state((uint16_t) vertex)
+								== Board::EMPTY) {
+					moves.push_back(vertex);
 				}
 			}
 		}
-	} else {
-		for (int i = 0; i < size; i++) {
-			for (int j = 0; j < size; j++) {
-				int move_x = (i + x_offset) % size;
-				int move_y = (j + y_offset) % size;
-				Game test = Game(input);
-				if (test.move(move_x, move_y)) {
-					double score = minimax(test, depth - 1, minScore, maxScore);
-					if (score < bestScore) {
-						bestScore = score;
-						bestX = move_x;
-						bestY = move_y;
-					}
+		order_by_pattern(input, moves);
+		for (size_t k = 0; k < moves.size() && !cutoff; k++) {
+			cutoff = visit(moves[k]);
+		}
+	}
+	for (int i = 0; i < size && !cutoff && !move_patterns; i++) {
+		for (int j = 0; j < size && !cutoff; j++) {
+			int vertex = input.get_vertex((i + x_offset) % size, (j + y_offset) % size);
+			cutoff = vertex != stored_move && visit(vertex);
+		}
+	}
+
+	if (best_move == Board::PASS) {
+		return minimax(input, 0, alpha, beta, evaluator); //only a pass is left
+	}
+	if (transposition && !search_clock.stopped) {
+		TransTable::bound_t bound = TransTable::EXACT;
+		if (bestScore <= alpha_in) {
+			bound = TransTable::UPPER;
+		} else if (bestScore >= beta_in) {
+			bound = TransTable::LOWER;
+		}
+		transposition->store(key, bestScore, depth, bound, best_move);
+	}
+	return bestScore;
+}
+
+int fuseki(Game input, const OpeningBook &book) {
+	int move;
+	if (!book.probe(input, input.side(), move)) {
+		return 0;
+	}
+	return input.move(move) ? move : 0; //a hash collision can suggest anything
+}
+
+SearchResult search(Game input, const SearchLimits &limits,
+		Evaluator *evaluator) {
+	TRACE_SCOPE("search");
+	auto start = std::chrono::steady_clock::now();
+	bool maximize = input.side();
+	SearchResult result = { Board::PASS, 0, 0, 0, 0, { }, SearchStats(), { }, 0 };
+
+	//once the opponent has passed, passing back ends a game that is already won
+	if (input.passed()) {
+		double final = input.final_score(input.get_komi());
+		if (maximize ? final > 0 : final < 0) {
+			result.score = final;
+			return result;
+		}
+	}
+
+	input.benson(true); //children inherit the settled areas found at the root
+	input.benson(false);
+	struct RootMove {
+		int move;
+		Game game;
+		double score;
+	};
+	std::vector<RootMove> root;
+	int size = input.get_size();
+	int x_offset = rand() % size;
+	int y_offset = rand() % size;
+	for (int i = 0; i < size; i++) {
+		for (int j = 0; j < size; j++) {
+			int vertex = input.get_vertex((i + x_offset) % size,
+					(j + y_offset) % size);
+			if (!worth_playing(input, vertex)) {
+				continue;
+			}
+			Game test = Game(input);
+			if (test.move(vertex)) {
+				root.push_back( { vertex, test, 0 });
+			}
+		}
+	}
+	if (root.empty()) {
+		result.score = input.final_score(input.get_komi());
+		return result;
+	}
+	if (move_patterns) {
+		const Board &board = input.get_board();
+		std::stable_sort(root.begin(), root.end(),
+				[&board, maximize](const RootMove &a, const RootMove &b) {
+					return move_patterns->weight(board.get_pattern(a.move), maximize)
+							> move_patterns->weight(board.get_pattern(b.move), maximize);
+				});
+	}
+	search_clock = SearchClock();
+	search_clock.searching = true;
+	set_leaf_weights(limits.weights);
+	search_clock.start = start;
+	search_clock.cache_probes = leaf_cache.get_probes();
+	search_clock.cache_hits = leaf_cache.get_hits();
+
+	//a move stored by an earlier search, maybe in another process, goes first
+	TransTable::Result stored;
+	uint64_t key = transposition ? search_key(input, evaluator) : 0;
+	search_clock.stats.tt_probes += transposition ? 1 : 0;
+	if (transposition && transposition->probe(key, stored)) {
+		search_clock.stats.tt_hits++;
+		std::stable_partition(root.begin(), root.end(),
+				[&stored](const RootMove &candidate) {
+					return candidate.move == stored.move;
+				});
+	}
+	result.move = root[0].move;
+
+	search_clock.timed = limits.seconds > 0;
+	search_clock.deadline = start
+			+ std::chrono::microseconds((int64_t) (limits.seconds * 1e6));
+	search_clock.max_nodes = limits.nodes;
+	pv = PrincipalVariation();
+	for (int depth = 1; depth <= std::min(limits.depth, MAX_PLY); depth++) {
+		TRACE_SCOPE("iteration");
+		double alpha = minScore;
+		double beta = maxScore;
+		int best = -1;
+		bool first_done = false; //the previous best move is always searched first
+		std::vector<int> line;
+		uint64_t nodes_before = search_clock.nodes;
+		uint64_t leaves_before = search_clock.stats.leaf_evaluations;
+		auto iteration_start = std::chrono::steady_clock::now();
+		for (size_t k = 0; k < root.size(); k++) {
+			pv.ply = 1;
+			double score = minimax(root[k].game, depth - 1, alpha, beta, evaluator);
+			if (search_clock.stopped) {
+				break;
+			}
+			root[k].score = score;
+			first_done = true;
+			if (best < 0 || (maximize ? score > root[best].score :
+										score < root[best].score)) {
+				best = k;
+				line.assign(1, root[k].move);
+				line.insert(line.end(), pv.moves[1], pv.moves[1] + pv.length[1]);
+				if (maximize) {
+					alpha = std::max(alpha, score);
+				} else {
+					beta = std::min(beta, score);
 				}
 			}
 		}
+		if (best >= 0 && first_done) {
+			result.move = root[best].move;
+			result.score = root[best].score;
+			result.pv = line;
+		}
+		if (search_clock.stopped) {
+			break;
+		}
+		result.depth = depth;
+		result.iterations.push_back( { depth, search_clock.nodes - nodes_before,
+				search_clock.stats.leaf_evaluations - leaves_before, std::chrono::duration<double>(
+						std::chrono::steady_clock::now() - iteration_start).count() });
+
+		std::stable_sort(root.begin(), root.end(),
+				[maximize](const RootMove &a, const RootMove &b) {
+					return maximize ? a.score > b.score : a.score < b.score;
+				});
+		//the next iteration costs a whole extra ply, don't start what can't finish
+		double elapsed = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		if (search_clock.timed && elapsed > 0.5 * limits.seconds) {
+			break;
+		}
 	}
-	return input.get_vertex(bestX, bestY);
+
+	if (transposition && result.depth > 0 && !search_clock.stopped) {
+		transposition->store(key, result.score, result.depth, TransTable::EXACT,
+				result.move);
+	}
+	result.stats = running_stats();
+	result.stats.searches = 1;
+	result.nodes = result.stats.nodes;
+	result.seconds = result.stats.seconds;
+	if (!result.iterations.empty()) {
+		//the uniform tree with as many leaves as the deepest iteration scored
+		const IterationStats &last = result.iterations.back();
+		result.branching_factor = std::pow(
+				(double) std::max<uint64_t>(last.leaf_evaluations, 1), 1.0 / last.depth);
+	}
+	thread_search_counters().finish(result.stats);
+	search_clock = SearchClock(); //plain minimax calls run unlimited again
+	set_leaf_weights(ScoreWeights()); //and score with the defaults
+	return result;
 }
 
+int bestMove(Game input, uint8_t depth, Evaluator *evaluator) {
+	SearchLimits limits;
+	limits.depth = depth;
+	return search(input, limits, evaluator).move;
+}
@@ -10,17 +10,64 @@
 
 #include "Game.h"
 #include "Board.h"
+#include "SearchStats.h"
 #include <random>
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <vector>
+
+class Evaluator;
+class OpeningBook;
+class TransTable;
+class PatternTable;
+
+#define MAX_PLY 64 //deepest line the search follows
+
+struct SearchLimits {
+	double seconds = 0; //wall clock budget, 0 for none
+	int depth = 2; //deepest iteration, at most MAX_PLY
+	uint64_t nodes = 0; //0 for none
+	ScoreWeights weights; //of the cached Game::score() leaves, for tuning
+};
+
+struct SearchResult {
+	int move; //Board::PASS when nothing is worth playing
+	double score; //black's point of view
+	int depth; //deepest completed iteration
+	uint64_t nodes;
+	double seconds;
+	std::vector<int> pv; //principal variation, starting with move
+	SearchStats stats;
+	std::vector<IterationStats> iterations; //completed ones, depth 1 first
+	double branching_factor; //leaves of the deepest iteration ^ (1 / depth)
+};
 
 double vertex_influence(int x, int y, uint8_t board_size);
 
-double minimax(Game input, uint8_t depth, double alpha, double beta);
+double evaluate(Game &input); //cached Game::score()
+
+//value of the best child, evaluated as one batch
+double best_leaf(Game &input, Evaluator *evaluator = nullptr);
+
+//leaves use the cached Game::score() unless an evaluator is given
+double minimax(Game input, uint8_t depth, double alpha, double beta,
+		Evaluator *evaluator = nullptr);
+
+//the book move for this position, 0 when out of book
+int fuseki(Game input, const OpeningBook &book);
+
+//iterative deepening until the limits run out, the best move of the deepest
+//iteration that got through its previous best move is returned
+SearchResult search(Game input, const SearchLimits &limits,
+		Evaluator *evaluator = nullptr);
+
+//searches store their results in table and start from what it holds, null for none
+void set_transposition_table(TransTable *table);
 
-int fuseki(Game input);
+//moves are tried heaviest pattern first, null for the board order
+void set_pattern_table(const PatternTable *table);
 
-int bestMove(Game input, uint8_t depth);
+int bestMove(Game input, uint8_t depth, Evaluator *evaluator = nullptr);
 
 #endif /* AI_H_ */
@@ -0,0 +1,269 @@
+/*
+ * Analysis.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Analysis.h"
+#include "Evaluator.h"
+#include "Json.h"
+#include "Game.h"
+#include "MCTS.h"
+#include "TransTable.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#define ANALYSIS_QUEUE_PER_WORKER 2 //lines read ahead, keeps memory bounded
+#define ANALYSIS_MAX_SECONDS 86400.0
+
+static bool build_position(const JsonValue &request, Game &game,
+		std::string &error) {
+	const JsonValue *position = request.get("position");
+	if (position && position->type == JsonValue::STRING) {
+		int size = game.get_size();
+		int index = 0;
+		for (char c : position->text) {
+			if (c == '/' || c == ' ' || c == '\n') {
+				continue;
+			}
+			if (index >= size * size) {
+				error = "position has more points than the board";
+				return false;
+			}
+			int vertex = game.get_vertex(index / size, index % size);
+			index++;
+			if (c == 'X' || c == 'x' || c == 'B' || c == 'b') {
+				game.setup(vertex, true);
+			} else if (c == 'O' || c == 'o' || c == 'W' || c == 'w') {
+				game.setup(vertex, false);
+			} else if (c != '.') {
+				error = std::string("unknown point '") + c + "' in position";
+				return false;
+			}
+		}
+		if (index != size * size) {
+			error = "position has fewer points than the board";
+			return false;
+		}
+		const JsonValue *to_move = request.get("to_move");
+		if (to_move && to_move->type == JsonValue::STRING) {
+			game.set_to_move(to_move->text != "w" && to_move->text != "W"
+					&& to_move->text != "white");
+		}
+	}
+
+	const JsonValue *moves = request.get("moves");
+	if (moves && moves->type == JsonValue::ARRAY) {
+		for (const JsonValue &item : moves->items) {
+			if (item.type != JsonValue::STRING) {
+				error = "moves must be strings";
+				return false;
+			}
+			//an optional colour in front, "B D4", otherwise colours alternate
+			std::string text = item.text;
+			size_t space = text.find(' ');
+			if (space != std::string::npos) {
+				char colour = text[0];
+				game.set_to_move(colour == 'B' || colour == 'b');
+				text = text.substr(space + 1);
+			}
+			int move = game.text_to_move(text);
+			if (move == NUM_VERTICES || !game.move(move)) {
+				error = "illegal move " + item.text;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+std::string analyze_request(const std::string &line,
+		const AnalysisDefaults &defaults) {
+	JsonValue request;
+	std::string error;
+	std::ostringstream out;
+	if (!json_parse(line, request, error) || request.type != JsonValue::OBJECT) {
+		out << "{\"id\": null, \"error\": "
+				<< json_quote(error.empty() ? "request is not an object" : error)
+				<< "}";
+		return out.str();
+	}
+	const JsonValue *id = request.get("id");
+	std::string id_text = "null";
+	if (id && id->type == JsonValue::STRING) {
+		id_text = json_quote(id->text);
+	} else if (id && id->type == JsonValue::NUMBER) {
+		id_text = id->text;
+	}
+	out << "{\"id\": " << id_text;
+
+	const JsonValue *field;
+	int size = defaults.board_size;
+	if ((field = request.get("boardsize")) && field->type == JsonValue::NUMBER) {
+		size = (int) field->number;
+	}
+	if (size < 2 || size > MAX_BOARDSIZE
+			|| (defaults.only_size && size != defaults.only_size)) {
+		out << ", \"error\": \"unsupported boardsize\"}";
+		return out.str();
+	}
+	Game game(size);
+	game.set_komi(defaults.komi);
+	if ((field = request.get("komi")) && field->type == JsonValue::NUMBER) {
+		game.set_komi(field->number);
+	}
+	SearchLimits limits = defaults.limits;
+	if ((field = request.get("seconds")) && field->type == JsonValue::NUMBER) {
+		if (!(field->number >= 0 && field->number <= ANALYSIS_MAX_SECONDS)) {
+			out << ", \"error\": \"seconds out of range\"}";
+			return out.str();
+		}
+		limits.seconds = field->number;
+	}
+	if ((field = request.get("depth")) && field->type == JsonValue::NUMBER) {
+		//minimax counts plies in a uint8_t, so a huge depth would wrap
+		limits.depth = (int) std::max(1.0, std::min((double) MAX_PLY, field->number));
+	}
+	if ((field = request.get("nodes")) && field->type == JsonValue::NUMBER) {
+		if (!(field->number >= 0 && field->number < 1e18)) {
+			out << ", \"error\": \"nodes out of range\"}";
+			return out.str();
+		}
+		limits.nodes = (uint64_t) field->number;
+	}
+	if (defaults.playouts <= 0 && limits.seconds <= 0 && !limits.nodes) {
+		//an unbounded search would pin its worker for good
+		out << ", \"error\": \"request needs a seconds or nodes budget\"}";
+		return out.str();
+	}
+	if (!build_position(request, game, error)) {
+		out << ", \"error\": " << json_quote(error) << "}";
+		return out.str();
+	}
+
+	char numbers[128];
+	if (defaults.playouts > 0) {
+		HeuristicEvaluator heuristic;
+		auto start = std::chrono::steady_clock::now();
+		MCTS tree(defaults.evaluator ? *defaults.evaluator : heuristic);
+		int move = tree.search(game, defaults.playouts);
+		double seconds = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		std::string text = json_quote(game.move_to_text(move));
+		snprintf(numbers, sizeof(numbers), "%.3f", tree.get_root_value());
+		out << ", \"move\": " << text << ", \"score\": " << numbers
+				<< ", \"pv\": [" << text << "]";
+		snprintf(numbers, sizeof(numbers),
+				", \"playouts\": %d, \"nodes\": %llu, \"seconds\": %.3f}",
+				defaults.playouts, (unsigned long long) tree.get_nodes(), seconds);
+		out << numbers;
+		return out.str();
+	}
+
+	SearchResult result = search(game, limits, defaults.evaluator);
+	out << ", \"move\": " << json_quote(game.move_to_text(result.move));
+	snprintf(numbers, sizeof(numbers), ", \"score\": %.3f", result.score);
+	out << numbers << ", \"pv\": [";
+	for (size_t i = 0; i < result.pv.size(); i++) {
+		out << (i ? ", " : "") << json_quote(game.move_to_text(result.pv[i]));
+	}
+	snprintf(numbers, sizeof(numbers),
+			"], \"depth\": %d, \"nodes\": %llu, \"seconds\": %.3f", result.depth,
+			(unsigned long long) result.nodes, result.seconds);
+	out << numbers << ", \"search\": " << search_result_json(result) << "}";
+	return out.str();
+}
+
+int analyze_main(int argc, char *argv[]) {
+	int threads = (argc > 0) ? std::stoi(argv[0]) :
+								std::max(1u, std::thread::hardware_concurrency());
+	if (threads < 1) {
+		//no worker would ever take a line off the queue
+		fprintf(stderr, "analyze needs at least one thread\n");
+		return 1;
+	}
+	AnalysisDefaults defaults;
+	defaults.limits.seconds = (argc > 1) ? std::stod(argv[1]) : 1.0;
+	defaults.limits.depth = 32; //timed requests stop on the clock first
+	TransTable cache;
+	if (argc > 2 && std::string(argv[2]) != "-") {
+		if (!cache.open(argv[2], TT_DEFAULT_SIZE_LOG2)) {
+			fprintf(stderr, "cannot open cache %s\n", argv[2]);
+			return 1;
+		}
+		set_transposition_table(&cache);
+	}
+	LoadedNetwork network;
+	if (argc > 3 && std::string(argv[3]) != "-") {
+		if (!network.load(argv[3], 16)) {
+			fprintf(stderr, "cannot load network %s\n", argv[3]);
+			return 1;
+		}
+		defaults.evaluator = &network.get_evaluator();
+		defaults.only_size = network.get_boardsize();
+		defaults.board_size = network.get_boardsize();
+	}
+	defaults.playouts = (argc > 4) ? std::stoi(argv[4]) : 0;
+
+	std::mutex mutex;
+	std::condition_variable has_work, has_room;
+	std::deque<std::string> pending;
+	bool done = false;
+	size_t capacity = ANALYSIS_QUEUE_PER_WORKER * threads;
+
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads; i++) {
+		workers.emplace_back([&]() {
+			while (true) {
+				std::string line;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					has_work.wait(lock, [&]() {
+						return done || !pending.empty();
+					});
+					if (pending.empty()) {
+						return;
+					}
+					line = std::move(pending.front());
+					pending.pop_front();
+				}
+				has_room.notify_one();
+				std::string reply = analyze_request(line, defaults);
+				std::lock_guard<std::mutex> lock(mutex);
+				std::cout << reply << '\n' << std::flush;
+			}
+		});
+	}
+
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		if (line.find_first_not_of(" \t\r") == std::string::npos) {
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(mutex);
+		has_room.wait(lock, [&]() {
+			return pending.size() < capacity;
+		});
+		pending.push_back(line);
+		has_work.notify_one();
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		done = true;
+	}
+	has_work.notify_all();
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	set_transposition_table(nullptr);
+	return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Analysis.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef ANALYSIS_H_
+#define ANALYSIS_H_
+
+#include "AI.h"
+#include <cstdint>
+#include <string>
+
+//settings for requests that don't give their own
+struct AnalysisDefaults {
+	uint8_t board_size = 19;
+	double komi = 7.5;
+	SearchLimits limits;
+	Evaluator *evaluator = nullptr; //leaves, null for the cached Game::score()
+	int playouts = 0; //above 0 a tree search of this many replaces minimax
+	uint8_t only_size = 0; //the one size a network evaluator plays, 0 for any
+};
+
+//one request per line, for example
+//  {"id": 7, "boardsize": 9, "komi": 6.5, "moves": ["E5", "C3", "pass"],
+//   "seconds": 0.5, "depth": 6, "nodes": 100000}
+//instead of moves a position can be given row by row, with "to_move":
+//  {"id": "a", "boardsize": 5, "position": "X.O../.XO../...../...../.....", "to_move": "w"}
+//the reply is one line with the same id:
+//  {"id": 7, "move": "D4", "score": 1.500, "pv": ["D4", "C3"], "depth": 4,
+//   "nodes": 5312, "seconds": 0.498, "search": {...}}
+//with "search" as in search_result_json(), or {"id": 7, "error": "..."}.
+//depth is clamped to [1, MAX_PLY], and a minimax request needs seconds or
+//nodes above 0, from itself or the defaults.
+//scores are black's point of view. a tree search replies with its most
+//visited move, the root value as score and "playouts" in place of "depth"
+//and "search"
+std::string analyze_request(const std::string &line,
+		const AnalysisDefaults &defaults);
+
+//"GoAI analyze [threads] [seconds] [cache] [network] [playouts]", "-" for
+//none: requests on stdin, replies on stdout in the order they finish. every
+//worker has its own search state, apart from the optional TransTable file
+//and network they share
+int analyze_main(int argc, char *argv[]);
+
+#endif /* ANALYSIS_H_ */
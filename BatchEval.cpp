@@ -0,0 +1,224 @@
+/*
+ * BatchEval.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "BatchEval.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstring>
+
+#define DILATIONS 5
+#define EROSIONS 21
+#define LANE_BLOCK 16 //capacity is a multiple of the widest block
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCH_X86
+#endif
+
+//gcc vector extensions, comparisons give -1 per true lane. the same kernels
+//are compiled once for AVX2 (16 lanes) and once for the baseline (8 lanes)
+typedef int16_t lanes8 __attribute__((vector_size(16)));
+typedef int16_t lanes16 __attribute__((vector_size(32)));
+
+EvalBatch::EvalBatch(uint8_t board_size_, int capacity_) {
+	board_size = board_size_;
+	num_vertices = (board_size + 2) * (board_size + 2);
+	capacity = (capacity_ + LANE_BLOCK - 1) / LANE_BLOCK * LANE_BLOCK;
+	count = 0;
+	int stride = board_size + 2;
+	directions[0] = -1;
+	directions[1] = -stride;
+	directions[2] = 1;
+	directions[3] = stride;
+	diagonals[0] = -stride - 1;
+	diagonals[1] = -stride + 1;
+	diagonals[2] = stride - 1;
+	diagonals[3] = stride + 1;
+
+	Board empty(board_size);
+	degree = std::vector<int8_t>(num_vertices, 0);
+	edge_diagonal = std::vector<bool>(num_vertices, false);
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (!empty.valid_vertex(v)) {
+			continue;
+		}
+		on_board.push_back(v);
+		for (int i = 0; i < 4; i++) {
+			degree[v] += empty.valid_vertex(v + directions[i]);
+			if (!empty.valid_vertex(v + diagonals[i])) {
+				edge_diagonal[v] = true;
+			}
+		}
+	}
+
+	black = std::vector<int16_t>(num_vertices * capacity, 0);
+	white = std::vector<int16_t>(num_vertices * capacity, 0);
+	infl[0] = std::vector<int16_t>(num_vertices * capacity, 0);
+	infl[1] = std::vector<int16_t>(num_vertices * capacity, 0);
+	area = std::vector<int16_t>(capacity, 0);
+	territory = std::vector<int16_t>(capacity, 0);
+	prisoners = std::vector<int>(capacity, 0);
+}
+
+void EvalBatch::clear() {
+	count = 0;
+}
+
+int EvalBatch::add(const Game &game) {
+	if (full()) {
+		return -1;
+	}
+	const Board &board = game.get_board();
+	assert(board.get_boardsize() == board_size);
+	int lane = count++;
+	for (uint16_t v : on_board) {
+		Board::vertex_t state = board.get_state(v);
+		black[v * capacity + lane] = (state == Board::BLACK);
+		white[v * capacity + lane] = (state == Board::WHITE);
+	}
+	prisoners[lane] = board.get_net_prisoners();
+	return lane;
+}
+
+int EvalBatch::size() const {
+	return count;
+}
+
+bool EvalBatch::full() const {
+	return count == capacity;
+}
+
+uint8_t EvalBatch::get_boardsize() const {
+	return board_size;
+}
+
+void EvalBatch::evaluate(double *scores, const ScoreWeights &weights) {
+	TRACE_SCOPE("EvalBatch::evaluate");
+	TRACE_COUNT("batched positions", count);
+#ifdef BATCH_X86
+	static const bool avx2 = __builtin_cpu_supports("avx2");
+	if (avx2) {
+		evaluate_avx2();
+	} else {
+		evaluate_lanes<lanes8>();
+	}
+#else
+	evaluate_lanes<lanes8>();
+#endif
+	for (int lane = 0; lane < count; lane++) {
+		//same operations in the same order as Game::score()
+		double area_score = area[lane] + 0.0;
+		scores[lane] = area_score + weights.influence * (double) territory[lane]
+				+ weights.prisoners * prisoners[lane];
+	}
+}
+
+template<typename Block>
+__attribute__((always_inline)) inline void EvalBatch::evaluate_lanes() {
+	count_area<Block>();
+	bouzy<Block>();
+}
+
+#ifdef BATCH_X86
+__attribute__((target("avx2")))
+void EvalBatch::evaluate_avx2() {
+	evaluate_lanes<lanes16>();
+}
+#endif
+
+//planes are plain int16_t arrays, so blocks are copied in and out unaligned
+#define LOAD(p) ({ Block loaded; memcpy(&loaded, (p), sizeof(Block)); loaded; })
+#define STORE(p, value) ({ Block stored = (value); memcpy((p), &stored, sizeof(Block)); })
+
+template<typename Block>
+__attribute__((always_inline)) inline void EvalBatch::count_area() {
+	//padding lanes past count are computed too, their results are never read.
+	//comparisons on Block give -1 per true lane
+	const int BLOCK = sizeof(Block) / sizeof(int16_t);
+	int lanes = (count + BLOCK - 1) / BLOCK * BLOCK;
+	std::fill(area.begin(), area.begin() + lanes, 0);
+	for (uint16_t v : on_board) {
+		const int16_t *b = &black[v * capacity];
+		const int16_t *w = &white[v * capacity];
+		const int16_t deg = degree[v];
+		const int16_t diagonal_limit = edge_diagonal[v] ? 0 : 1; //see Board::classify_eye
+		for (int lane = 0; lane < lanes; lane += BLOCK) {
+			Block black_sides = { }, white_sides = { };
+			Block black_corners = { }, white_corners = { };
+			for (int i = 0; i < 4; i++) {
+				black_sides += LOAD(&black[(v + directions[i]) * capacity + lane]);
+				white_sides += LOAD(&white[(v + directions[i]) * capacity + lane]);
+				black_corners += LOAD(&black[(v + diagonals[i]) * capacity + lane]);
+				white_corners += LOAD(&white[(v + diagonals[i]) * capacity + lane]);
+			}
+			Block stones = LOAD(b + lane) - LOAD(w + lane);
+			Block empty = (LOAD(b + lane) + LOAD(w + lane)) == 0;
+			Block black_eye = empty & (black_sides == deg)
+					& (white_corners <= diagonal_limit);
+			Block white_eye = empty & (white_sides == deg)
+					& (black_corners <= diagonal_limit);
+			STORE(&area[lane],
+					LOAD(&area[lane]) + stones - 2 * (black_eye - white_eye));
+		}
+	}
+}
+
+template<typename Block>
+__attribute__((always_inline)) inline void EvalBatch::bouzy() {
+	//the same 5/21 operator as Influence.cpp, with lanes instead of columns
+	const int BLOCK = sizeof(Block) / sizeof(int16_t);
+	int lanes = (count + BLOCK - 1) / BLOCK * BLOCK;
+	for (uint16_t v : on_board) {
+		for (int lane = 0; lane < lanes; lane += BLOCK) {
+			STORE(&infl[0][v * capacity + lane],
+					128 * (LOAD(&black[v * capacity + lane])
+							- LOAD(&white[v * capacity + lane])));
+		}
+	}
+
+	int current = 0;
+	for (int step = 0; step < DILATIONS + EROSIONS; step++) {
+		const int16_t *src = infl[current].data();
+		int16_t *dst = infl[1 - current].data();
+		for (uint16_t v : on_board) {
+			const int16_t deg = degree[v];
+			for (int lane = v * capacity; lane < v * capacity + lanes; lane +=
+			BLOCK) {
+				Block x = LOAD(src + lane);
+				Block n[4];
+				for (int i = 0; i < 4; i++) {
+					n[i] = LOAD(src + lane + directions[i] * capacity);
+				}
+				//negated neighbor counts
+				Block pos = (n[0] > 0) + (n[1] > 0) + (n[2] > 0) + (n[3] > 0);
+				Block neg = (n[0] < 0) + (n[1] < 0) + (n[2] < 0) + (n[3] < 0);
+				if (step < DILATIONS) {
+					Block grow = (x >= 0) & (neg == 0);
+					Block shrink = (x <= 0) & (pos == 0) & ~grow;
+					STORE(dst + lane, x - (grow & pos) + (shrink & neg));
+				} else {
+					Block down = x - deg - pos;
+					Block up = x + deg + neg;
+					STORE(dst + lane,
+							((x > 0) & down & (down > 0)) | ((x < 0) & up & (up < 0)));
+				}
+			}
+		}
+		current = 1 - current;
+	}
+
+	std::fill(territory.begin(), territory.begin() + lanes, 0);
+	for (uint16_t v : on_board) {
+		for (int lane = 0; lane < lanes; lane += BLOCK) {
+			Block x = LOAD(&infl[current][v * capacity + lane]);
+			STORE(&territory[lane],
+					LOAD(&territory[lane]) - (x > 0) + (x < 0));
+		}
+	}
+}
+
+EvalBatch::~EvalBatch() {
+}
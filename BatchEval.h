@@ -0,0 +1,56 @@
+/*
+ * BatchEval.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef BATCHEVAL_H_
+#define BATCHEVAL_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <vector>
+
+//scores many positions of one board size at once. positions are stored as
+//vertex-major planes (plane[vertex * capacity + lane]) so every loop over
+//lanes is a contiguous, vectorizable run. scores match Game::score() exactly
+class EvalBatch {
+public:
+	EvalBatch(uint8_t board_size, int capacity = 64);
+
+	void clear();
+	int add(const Game &game); //returns the lane, or -1 if the batch is full
+	int size() const;
+	bool full() const;
+	uint8_t get_boardsize() const;
+
+	void evaluate(double *scores, const ScoreWeights &weights = ScoreWeights());
+
+	virtual ~EvalBatch();
+private:
+	uint8_t board_size;
+	uint16_t num_vertices;
+	int capacity;
+	int count;
+
+	std::vector<uint16_t> on_board; //vertices inside the edge
+	std::vector<int8_t> degree; //on-board orthogonal neighbors
+	std::vector<bool> edge_diagonal; //a diagonal neighbor is off the board
+	int directions[4];
+	int diagonals[4];
+
+	std::vector<int16_t> black; //1 where a lane has a black stone
+	std::vector<int16_t> white;
+	std::vector<int16_t> infl[2];
+	std::vector<int16_t> area; //stones + 2 * eyes, per lane
+	std::vector<int16_t> territory; //bouzy estimate, per lane
+	std::vector<int> prisoners;
+
+	void evaluate_avx2();
+	template<typename Block> void evaluate_lanes();
+	template<typename Block> void count_area();
+	template<typename Block> void bouzy();
+};
+
+#endif /* BATCHEVAL_H_ */
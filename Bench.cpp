@@ -0,0 +1,483 @@
+/*
+ * Bench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Bench.h"
+#include "Influence.h"
+#include "BatchEval.h"
+#include "Network.h"
+#include "NNQueue.h"
+#include "Playout.h"
+#include "Sgf.h"
+#include "MCTS.h"
+#include "Evaluator.h"
+#include "MicroBench.h"
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdio>
+
+std::vector<Game> bench_positions(uint8_t board_size, int count, int moves,
+		uint32_t seed) {
+	std::mt19937 randGen(seed);
+	std::vector<Game> out;
+	for (int i = 0; i < count; i++) {
+		Game game(board_size);
+		int played = 0;
+		for (int tries = 0; played < moves && tries < moves * 20; tries++) {
+			if (game.move((uint8_t) (randGen() % board_size),
+					(uint8_t) (randGen() % board_size))) {
+				played++;
+			}
+		}
+		out.push_back(game);
+	}
+	return out;
+}
+
+void bench_influence(int seconds) {
+	const influence_path_t paths[] = { INFLUENCE_SCALAR, INFLUENCE_SSE2,
+			INFLUENCE_AVX2 };
+	for (uint8_t size : { 9, 13, 19 }) {
+		std::vector<Game> positions = bench_positions(size, 64,
+				size * size / 3, 1);
+		std::vector<Board> boards;
+		for (Game &game : positions) {
+			boards.push_back(game.get_board());
+		}
+
+		//every path has to agree with the scalar reference on every position
+		for (influence_path_t path : paths) {
+			if (!influence_path_supported(path)) {
+				continue;
+			}
+			for (const Board &board : boards) {
+				if (bouzy_influence(board, path)
+						!= bouzy_influence(board, INFLUENCE_SCALAR)) {
+					printf("%dx%d %s: MISMATCH\n", size, size,
+							influence_path_name(path));
+					break;
+				}
+			}
+		}
+
+		for (influence_path_t path : paths) {
+			if (!influence_path_supported(path)) {
+				printf("%dx%d %-6s unsupported\n", size, size,
+						influence_path_name(path));
+				continue;
+			}
+			auto start = std::chrono::steady_clock::now();
+			auto stop = start + std::chrono::milliseconds(seconds * 1000 / 3);
+			uint64_t evaluations = 0;
+			volatile int sink = 0;
+			while (std::chrono::steady_clock::now() < stop) {
+				for (const Board &board : boards) {
+					sink += bouzy_influence(board, path);
+				}
+				evaluations += boards.size();
+			}
+			double elapsed = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			printf("%dx%d %-6s %12.0f evals/s\n", size, size,
+					influence_path_name(path), evaluations / elapsed);
+		}
+	}
+}
+
+void bench_batch(int seconds) {
+	for (uint8_t size : { 9, 13, 19 }) {
+		std::vector<Game> positions = bench_positions(size, 64,
+				size * size / 3, 2);
+		EvalBatch batch(size, positions.size());
+		std::vector<double> scores(positions.size());
+		for (Game &game : positions) {
+			batch.add(game);
+		}
+		batch.evaluate(scores.data());
+		for (size_t i = 0; i < positions.size(); i++) {
+			if (scores[i] != positions[i].score()) {
+				printf("%dx%d batch: MISMATCH at position %zu\n", size, size, i);
+				break;
+			}
+		}
+
+		auto run = [&](bool batched) {
+			auto start = std::chrono::steady_clock::now();
+			auto stop = start + std::chrono::milliseconds(seconds * 1000 / 6);
+			uint64_t evaluations = 0;
+			volatile double sink = 0;
+			while (std::chrono::steady_clock::now() < stop) {
+				if (batched) {
+					batch.clear();
+					for (Game &game : positions) {
+						batch.add(game);
+					}
+					batch.evaluate(scores.data());
+					sink += scores[0];
+				} else {
+					for (Game &game : positions) {
+						sink += game.score();
+					}
+				}
+				evaluations += positions.size();
+			}
+			return evaluations
+					/ std::chrono::duration<double>(
+							std::chrono::steady_clock::now() - start).count();
+		};
+		printf("%dx%d single %12.0f evals/s\n", size, size, run(false));
+		printf("%dx%d batch  %12.0f evals/s\n", size, size, run(true));
+	}
+}
+
+void bench_network(int seconds, const std::string &weights) {
+	Network network;
+	if (weights.empty()) {
+		network.init_random(9, 32, 4, 1);
+	} else if (!network.load(weights)) {
+		printf("could not load %s\n", weights.c_str());
+		return;
+	}
+	uint8_t size = network.get_boardsize();
+	int vertices = size * size;
+	printf("network %dx%d, %d channels, %d blocks\n", size, size,
+			network.get_channels(), network.get_blocks());
+	std::vector<Game> positions = bench_positions(size, 64, vertices / 3, 3);
+	std::vector<float> inputs(positions.size() * NETWORK_INPUT_PLANES * vertices);
+	for (size_t i = 0; i < positions.size(); i++) {
+		Network::input_planes(positions[i],
+				&inputs[i * NETWORK_INPUT_PLANES * vertices]);
+	}
+	std::vector<float> policy(positions.size() * (vertices + 1));
+	std::vector<float> values(positions.size());
+
+	const int batch_sizes[] = { 1, 2, 4, 8, 16, 32, 64 };
+	for (int batch : batch_sizes) {
+		auto start = std::chrono::steady_clock::now();
+		auto stop = start + std::chrono::milliseconds(seconds * 1000 / 9);
+		uint64_t evaluated = 0;
+		while (std::chrono::steady_clock::now() < stop) {
+			network.forward(inputs.data(), batch, policy.data(), values.data());
+			evaluated += batch;
+		}
+		double elapsed = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		printf("forward batch %2d %10.0f positions/s\n", batch, evaluated / elapsed);
+	}
+
+	//search threads meeting in the queue
+	for (int threads : { 8, 32 }) {
+		NNQueue queue(network, 16);
+		std::atomic<bool> done(false);
+		std::atomic<uint64_t> evaluated(0);
+		std::vector<std::thread> workers;
+		auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				for (size_t i = t; !done; i = (i + threads) % positions.size()) {
+					queue.submit(positions[i]).get();
+					evaluated++;
+				}
+			});
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(seconds * 1000 / 9));
+		done = true;
+		for (std::thread &worker : workers) {
+			worker.join();
+		}
+		double elapsed = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		printf("queue %2d threads %10.0f positions/s, %.1f per batch\n", threads,
+				evaluated / elapsed, (double) queue.get_positions()
+						/ std::max<uint64_t>(1, queue.get_batches()));
+	}
+}
+
+void bench_score(int seconds) {
+	for (uint8_t size : { 9, 13, 19 }) {
+		//finished boards from random playouts, the positions scoring is for
+		std::mt19937 randGen(1);
+		std::vector<Board> finals;
+		uint64_t playouts = 0;
+		auto start = std::chrono::steady_clock::now();
+		auto stop = start + std::chrono::milliseconds(seconds * 1000 / 6);
+		while (std::chrono::steady_clock::now() < stop) {
+			Game game(size);
+			playout(game, 7.5, randGen);
+			if (finals.size() < 256) {
+				finals.push_back(game.get_board());
+			}
+			playouts++;
+		}
+		double playout_time = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count() / playouts;
+
+		//the ownership map has to add up to the score
+		std::vector<int8_t> ownership;
+		for (const Board &board : finals) {
+			int total = 0;
+			double score = board.area_score(0, ownership);
+			for (int8_t owner : ownership) {
+				total += owner;
+			}
+			if (total != score) {
+				printf("%dx%d: OWNERSHIP MISMATCH\n", size, size);
+				break;
+			}
+		}
+
+		uint64_t scored = 0;
+		double checksum = 0;
+		start = std::chrono::steady_clock::now();
+		stop = start + std::chrono::milliseconds(seconds * 1000 / 6);
+		while (std::chrono::steady_clock::now() < stop) {
+			for (const Board &board : finals) {
+				checksum += board.area_score(7.5, ownership);
+			}
+			scored += finals.size();
+		}
+		double score_time = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count() / scored;
+		printf("%2dx%-2d playout %9.1f us   score %7.3f us   %.2f%% of a playout"
+				"   (%.0f)\n", size, size, playout_time * 1e6, score_time * 1e6,
+				100 * score_time / playout_time, checksum / scored);
+	}
+}
+
+void bench_sgf(int seconds) {
+	//an archive of random 19x19 games, written the way game records are
+	std::mt19937 randGen(1);
+	std::string archive;
+	std::vector<uint64_t> final_hashes;
+	std::vector<std::vector<std::string>> move_lists;
+	for (int i = 0; i < 200; i++) {
+		Game game(19);
+		const Board &board = game.get_board();
+		archive += "(;GM[1]FF[4]SZ[19]KM[7.5]PB[random]PW[random]\n";
+		move_lists.emplace_back();
+		for (int tries = 0; tries < 2000 && game.get_play_num() < 220; tries++) {
+			int vertex = game.get_vertex(randGen() % 19, randGen() % 19);
+			bool side = game.side();
+			if (!board.is_eye(vertex, side) && game.move(vertex)) {
+				std::string text = board.move_to_text_sgf(vertex);
+				archive += std::string(side ? ";B[" : ";W[") + text + "]";
+				move_lists.back().push_back(text);
+			}
+		}
+		archive += ")\n";
+		final_hashes.push_back(game.zobristHash());
+	}
+
+	//replayed games have to end on the same boards
+	size_t index = 0;
+	bool match = true;
+	SgfReplay check([&](Game &game) {
+		match = match && index < final_hashes.size()
+				&& game.zobristHash() == final_hashes[index];
+		index++;
+	});
+	std::string error;
+	if (!sgf_parse(archive.data(), archive.data() + archive.size(), check, true,
+			error) || !match || index != final_hashes.size()) {
+		printf("sgf replay: MISMATCH %s\n", error.c_str());
+		return;
+	}
+
+	uint64_t games = 0;
+	auto start = std::chrono::steady_clock::now();
+	auto stop = start + std::chrono::milliseconds(seconds * 1000 / 2);
+	while (std::chrono::steady_clock::now() < stop) {
+		SgfReplay replay(nullptr);
+		sgf_parse(archive.data(), archive.data() + archive.size(), replay, true,
+				error);
+		games += replay.get_games();
+	}
+	double elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	printf("sgf parse + quiet replay  %10.0f games/min  (%zu KB archive)\n",
+			games * 60 / elapsed, archive.size() / 1024);
+
+	//the parser alone, a visitor that ignores everything
+	games = 0;
+	start = std::chrono::steady_clock::now();
+	stop = start + std::chrono::milliseconds(seconds * 1000 / 4);
+	while (std::chrono::steady_clock::now() < stop) {
+		SgfVisitor ignore;
+		sgf_parse(archive.data(), archive.data() + archive.size(), ignore, true,
+				error);
+		games += final_hashes.size();
+	}
+	elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	printf("sgf parse only            %10.0f games/min\n", games * 60 / elapsed);
+
+	//pre-split strings through the checked Game::move. this is not the old
+	//replay path, Game::move is today's, so it shows what the superko and
+	//suicide checks cost next to play_quiet without any parsing
+	games = 0;
+	start = std::chrono::steady_clock::now();
+	stop = start + std::chrono::milliseconds(seconds * 1000 / 4);
+	while (std::chrono::steady_clock::now() < stop) {
+		for (const std::vector<std::string> &moves : move_lists) {
+			Game game(19);
+			for (const std::string &text : moves) {
+				game.move(game.get_board().text_to_move_sgf(text));
+			}
+			games++;
+		}
+	}
+	elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	printf("pre-split moves, checked  %10.0f games/min\n", games * 60 / elapsed);
+}
+
+static void scan_atari_moves(const Board &board, bool side,
+		std::vector<int> &out) {
+	//what callers had to do before the index: every stone, then the
+	//liberties of its chain from the chain's vertex map
+	out.clear();
+	int size = board.get_boardsize();
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			int vertex = board.get_vertex(x, y);
+			if (board.get_state((uint16_t) vertex) == Board::EMPTY
+					|| board.get_chain_liberties(vertex) != 1) {
+				continue;
+			}
+			for (int i = 0; i < 4; i++) {
+				int liberty = vertex + board.directions[i];
+				if (board.valid_vertex(liberty)
+						&& board.get_state((uint16_t) liberty) == Board::EMPTY
+						&& std::find(out.begin(), out.end(), liberty) == out.end()) {
+					out.push_back(liberty);
+				}
+			}
+		}
+	}
+	(void) side;
+}
+
+void bench_tactics(int seconds) {
+	for (uint8_t size : { 9, 19 }) {
+		std::vector<Game> games = bench_positions(size, 256, size * size / 2, 1);
+		std::vector<int> moves;
+		for (int path = 0; path < 2; path++) {
+			uint64_t calls = 0, found = 0;
+			auto start = std::chrono::steady_clock::now();
+			auto stop = start + std::chrono::milliseconds(seconds * 1000 / 4);
+			while (std::chrono::steady_clock::now() < stop) {
+				for (Game &game : games) {
+					if (path == 0) {
+						game.get_board().get_atari_moves(true, moves);
+					} else {
+						scan_atari_moves(game.get_board(), true, moves);
+					}
+					found += moves.size();
+				}
+				calls += games.size();
+			}
+			double elapsed = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			printf("%2dx%-2d %-12s %8.3f us per position   %.2f atari moves\n",
+					size, size, path == 0 ? "chain index" : "board scan",
+					elapsed * 1e6 / calls, (double) found / calls);
+		}
+	}
+}
+
+void bench_patterns(int seconds, const std::string &path) {
+	PatternTable table; //all weights 1 unless a file is given
+	if (!path.empty() && !table.load(path)) {
+		printf("cannot load patterns %s\n", path.c_str());
+		return;
+	}
+	for (uint8_t size : { 9, 19 }) {
+		for (int weighted = 0; weighted < 2; weighted++) {
+			std::mt19937 randGen(1);
+			uint64_t playouts = 0, moves = 0;
+			double total = 0;
+			auto start = std::chrono::steady_clock::now();
+			auto stop = start + std::chrono::milliseconds(seconds * 1000 / 4);
+			while (std::chrono::steady_clock::now() < stop) {
+				Game game(size);
+				total += weighted ? playout(game, 7.5, randGen, table) :
+									playout(game, 7.5, randGen);
+				moves += game.get_play_num();
+				playouts++;
+			}
+			double elapsed = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			printf("%2dx%-2d %-8s %9.1f us per playout   %5.1f moves   %+.2f mean score\n",
+					size, size, weighted ? "patterns" : "uniform",
+					elapsed * 1e6 / playouts, (double) moves / playouts,
+					total / playouts);
+		}
+	}
+}
+
+void bench_mcts(int seconds) {
+	HeuristicEvaluator evaluator;
+	for (uint8_t size : { 9, 19 }) {
+		std::vector<Game> games = bench_positions(size, 4, size * size / 4, 5);
+		for (int widened = 0; widened < 2; widened++) {
+			MCTS tree(evaluator);
+			if (!widened) {
+				tree.set_widening(0, 0, 0); //every child at the first visit, no bias
+			}
+			uint64_t searches = 0, nodes = 0;
+			auto start = std::chrono::steady_clock::now();
+			auto stop = start + std::chrono::milliseconds(seconds * 1000 / 4);
+			while (std::chrono::steady_clock::now() < stop) {
+				tree.search(games[searches % games.size()], 1000);
+				nodes += tree.get_nodes();
+				searches++;
+			}
+			double elapsed = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			printf("%2dx%-2d %-9s %8.0f playouts/s   %8.0f nodes per 1000 playouts\n",
+					size, size, widened ? "widening" : "full",
+					searches * 1000 / elapsed, (double) nodes / searches);
+		}
+	}
+}
+
+int bench_main(int argc, char *argv[]) {
+	std::string name = (argc > 0) ? argv[0] : "influence";
+	if (name == "core") { //takes milliseconds per operation and a format
+		return micro_bench_main(argc - 1, argv + 1);
+	}
+	int seconds = (argc > 1) ? std::stoi(argv[1]) : 3;
+	if (name == "influence") {
+		bench_influence(seconds);
+		return 0;
+	} else if (name == "batch") {
+		bench_batch(seconds);
+		return 0;
+	} else if (name == "score") {
+		bench_score(seconds);
+		return 0;
+	} else if (name == "sgf") {
+		bench_sgf(seconds);
+		return 0;
+	} else if (name == "tactics") {
+		bench_tactics(seconds);
+		return 0;
+	} else if (name == "mcts") {
+		bench_mcts(seconds);
+		return 0;
+	} else if (name == "patterns") {
+		bench_patterns(seconds, (argc > 2) ? argv[2] : "");
+		return 0;
+	} else if (name == "network") {
+		bench_network(seconds, (argc > 2) ? argv[2] : "");
+		return 0;
+	}
+	printf("unknown benchmark: %s\n", name.c_str());
+	return 1;
+}
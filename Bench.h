@@ -0,0 +1,32 @@
+/*
+ * Bench.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//positions reached by random legal moves, the same for every run with a seed
+std::vector<Game> bench_positions(uint8_t board_size, int count, int moves,
+		uint32_t seed);
+
+void bench_influence(int seconds);
+void bench_batch(int seconds);
+void bench_score(int seconds); //Tromp-Taylor scoring against a whole playout
+void bench_sgf(int seconds); //archive replay against the string based path
+void bench_tactics(int seconds); //atari moves from the chain index against a scan
+void bench_network(int seconds, const std::string &weights);
+void bench_patterns(int seconds, const std::string &path); //pattern playouts against uniform ones
+void bench_mcts(int seconds); //tree search with and without progressive widening
+
+//entry point for "GoAI bench <name>", returns the process exit code
+int bench_main(int argc, char *argv[]);
+
+#endif /* BENCH_H_ */
@@ -6,12 +6,15 @@
  */
 
 #include "Board.h"
+#include "Trace.h"
 #include <cassert>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <vector>
 #include <chrono>
+#include <random>
+#include <cmath>
 
 Board::Board() : Board(MAX_BOARDSIZE) {
 
@@ -22,6 +25,12 @@ Board::Board(uint8_t size) {
 	num_vertices = (board_size + 2) * (board_size + 2); //(19 + 2)*(19 + 2)
 	num_prisoners[0] = 0;
 	num_prisoners[1] = 0;
+	num_stones[0] = 0;
+	num_stones[1] = 0;
+	num_eyes[0] = 0;
+	num_eyes[1] = 0;
+	hashes.fill(0);
+	symmetries = symmetry_tables(board_size);
 	directions[0] = -1;
 	directions[1] = -board_size - 2;
 	directions[2] = 1;
@@ -30,6 +39,7 @@ Board::Board(uint8_t size) {
 	chains = std::vector<Chain>();
 	board = std::vector<vertex_t>(num_vertices, Board::vertex_t::EMPTY);
 	chain_reps = std::vector<uint8_t>(num_vertices, 255);
+	eyes = std::vector<uint8_t>(num_vertices, NO_EYE);
 
 	for (int i = 0; i < board_size + 2; i++) {
 		board[i] = Board::vertex_t::INVAL;
@@ -37,6 +47,13 @@ Board::Board(uint8_t size) {
 		board[i * (board_size + 2) + board_size + 1] = Board::vertex_t::INVAL;
 		board[i + (board_size + 2) * (board_size + 1)] = Board::vertex_t::INVAL;
 	}
+	patterns = std::vector<uint32_t>(num_vertices, 0);
+	pattern_flags = std::vector<uint8_t>(num_vertices, 0);
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (board[v] != INVAL) {
+			patterns[v] = compute_pattern(v);
+		}
+	}
 }
 
 uint8_t Board::get_boardsize() const {
@@ -118,9 +135,6 @@ std::string Board::move_to_text_sgf(const int16_t move) const {
 			move == Board::PASS || move == Board::RESIGN
 					|| (column >= 0 && column < board_size));
 
-// SGF inverts rows
-	row = board_size - row - 1;
-
 	if (move >= 0 && move < NUM_VERTICES) {
 		if (column <= 25) {
 			result << static_cast<char>('a' + column);
@@ -155,14 +169,21 @@ int Board::text_to_move_sgf(std::string move) const {
 			|| !std::isalpha(move[1])) {
 		return NUM_VERTICES;
 	}
+	return sgf_vertex(move[0], move[1]);
+}
 
-	uint8_t column = move[0] - 'a';
-	uint8_t row = move[1] - 'a';
-
-	if (row > board_size * board_size || column > board_size * board_size) {
+int Board::sgf_vertex(char column, char row) const {
+	//first letter is the column, second the row, both from 'a'.
+	//"tt" is the old way of writing a pass on boards up to 19x19
+	if (column == 't' && row == 't' && board_size <= 19) {
+		return PASS;
+	}
+	int x = row - 'a';
+	int y = column - 'a';
+	if (x < 0 || x >= board_size || y < 0 || y >= board_size) {
 		return NUM_VERTICES;
 	}
-	return get_vertex(row, column);
+	return get_vertex(x, y);
 }
 
 uint8_t Board::liberties(uint16_t vertex) const {
@@ -199,12 +220,21 @@ void Board::set_state(uint8_t x, uint8_t y, vertex_t content) {
 }
 
 void Board::set_state(uint16_t vertex, vertex_t new_state) {
+	TRACE_SCOPE("Board::set_state");
 	assert(valid_vertex(vertex));
 	assert(board[vertex] != Board::vertex_t::INVAL); //cannot change inval
 	assert(new_state != Board::vertex_t::INVAL); //cannot change to inval, inval is board edges
 	vertex_t previous_state = board[vertex];
 	//assert(previous_state != new_state); //cant change to the same state
+	for (uint16_t changed : pattern_changes) {
+		pattern_flags[changed] &= ~2;
+	}
+	pattern_changes.clear();
 	board[vertex] = new_state;
+	update_eyes(vertex);
+	mark_patterns(vertex);
+	num_stones[new_state == BLACK ? 0 : 1]++;
+	toggle_hashes(vertex, new_state);
 
 	assert(previous_state == EMPTY && new_state != EMPTY);
 	for (int i = 0; i < 4; i++) {
@@ -221,6 +251,9 @@ void Board::set_state(uint16_t vertex, vertex_t new_state) {
 		x.vertices = std::vector<uint8_t>(num_vertices, 0);
 		x.num_liberties = 0;
 		x.num_stones = 0;
+		x.liberty_sum = 0;
+		x.liberty_square_sum = 0;
+		x.low_list = -1;
 		chains.push_back(x);
 		chain_reps[vertex] = chains.size() - 1;
 		add_stone(chain_reps[vertex], vertex);
@@ -256,6 +289,7 @@ void Board::set_state(uint16_t vertex, vertex_t new_state) {
 			}
 		}
 	}
+	flush_patterns();
 }
 
 int Board::get_vertex(uint8_t x, uint8_t y) const {
@@ -283,7 +317,7 @@ void Board::print() const {
 				printf("# ");
 				break;
 			case vertex_t::EMPTY:
-				if (is_eye(i, true) || is_eye(i, false)) {
+				if (eyes[i] == BLACK_EYE || eyes[i] == WHITE_EYE) {
 					printf(". ");
 				} else if (is_starpoint(i)) {
 					printf("* ");
@@ -331,7 +365,80 @@ Board::~Board() {
 }
 
 double Board::area_score(double komi) const {
-	return 0;
+	static thread_local std::vector<int8_t> ownership;
+	return area_score(komi, ownership);
+}
+
+double Board::area_score(double komi, std::vector<int8_t> &ownership) const {
+	//Tromp-Taylor: a point is black's if it is black or only reaches black
+	//through empty points, likewise for white. every empty region is filled
+	//once, collecting the colours on its border as it goes
+	ownership.assign(num_vertices, 0);
+	static thread_local std::vector<uint16_t> region;
+	static thread_local std::vector<bool> seen;
+	seen.assign(num_vertices, false);
+	int total = 0;
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (board[v] == BLACK || board[v] == WHITE) {
+			ownership[v] = (board[v] == BLACK) ? 1 : -1;
+			total += ownership[v];
+			continue;
+		}
+		if (board[v] != EMPTY || seen[v]) {
+			continue;
+		}
+		region.clear();
+		region.push_back(v);
+		seen[v] = true;
+		int reaches = 0; //bit 0 black, bit 1 white
+		for (size_t i = 0; i < region.size(); i++) {
+			for (int d = 0; d < 4; d++) {
+				uint16_t neighbor = region[i] + directions[d];
+				if (board[neighbor] == EMPTY) {
+					if (!seen[neighbor]) {
+						seen[neighbor] = true;
+						region.push_back(neighbor);
+					}
+				} else if (board[neighbor] != INVAL) {
+					reaches |= board[neighbor]; //BLACK = 1, WHITE = 2
+				}
+			}
+		}
+		int8_t owner = (reaches == 1) ? 1 : (reaches == 2) ? -1 : 0;
+		if (owner) {
+			for (uint16_t point : region) {
+				ownership[point] = owner;
+			}
+			total += owner * (int) region.size();
+		}
+	}
+	return total - komi;
+}
+
+uint64_t Board::hash_after(uint16_t vertex, bool side) const {
+	//the stone itself plus every opponent chain whose last liberty it takes
+	vertex_t colour = side ? BLACK : WHITE;
+	uint64_t result = hashes[0] ^ zobrist_key(vertex, colour);
+	uint8_t captured[4];
+	int num_captured = 0;
+	for (int i = 0; i < 4; i++) {
+		uint16_t neighbor = vertex + directions[i];
+		if (board[neighbor] != EMPTY && board[neighbor] != INVAL
+				&& board[neighbor] != colour) {
+			uint8_t chain = chain_reps[neighbor];
+			if (chains[chain].num_liberties == 1
+					&& std::find(captured, captured + num_captured, chain)
+							== captured + num_captured) {
+				captured[num_captured++] = chain;
+				for (uint16_t p = 0; p < num_vertices; p++) {
+					if (chains[chain].vertices[p] == 1) {
+						result ^= zobrist_key(p, board[p]);
+					}
+				}
+			}
+		}
+	}
+	return result;
 }
 
 bool Board::is_starpoint(uint16_t vertex) const {
@@ -400,6 +507,7 @@ void Board::print_chains() const {
 }
 
 void Board::merge(uint16_t chain1, uint16_t chain2) {
+	TRACE_SCOPE("Board::merge");
 	assert(valid_vertex(chain1) && valid_vertex(chain2));
 //TODO test method
 	if (chain1 == chain2) {
@@ -421,6 +529,9 @@ void Board::merge(uint16_t chain1, uint16_t chain2) {
 	new_chain.vertices = std::vector<uint8_t>(num_vertices, 0);
 	new_chain.num_liberties = 0;
 	new_chain.num_stones = 0;
+	new_chain.liberty_sum = 0;
+	new_chain.liberty_square_sum = 0;
+	new_chain.low_list = -1;
 	for (int i = 0; i < num_vertices; i++) {
 		if (valid_vertex(i)) {
 			if ((current.vertices[i] == 1) || (other.vertices[i] == 1)) {
@@ -429,6 +540,8 @@ void Board::merge(uint16_t chain1, uint16_t chain2) {
 			} else if ((current.vertices[i] == 2) || (other.vertices[i] == 2)) {
 				new_chain.vertices[i] = 2;
 				new_chain.num_liberties++;
+				new_chain.liberty_sum += i;
+				new_chain.liberty_square_sum += i * i;
 			}
 		}
 	}
@@ -442,6 +555,7 @@ void Board::merge(uint16_t chain1, uint16_t chain2) {
 		}
 	}
 	chains.push_back(new_chain);
+	update_low_liberty(chains.size() - 1);
 }
 
 bool Board::add_stone(uint8_t chain_index, uint16_t vertex) {
@@ -476,8 +590,14 @@ bool Board::add_liberty(uint8_t chain_index, uint16_t vertex) {
 	if (chains[chain_index].vertices.at(vertex) != 0) { //can't be already a stone or liberty
 		return false;
 	}
+	if (chains[chain_index].num_liberties == 1) {
+		mark_pattern(chains[chain_index].liberty_sum); //no longer next to an atari
+	}
 	chains[chain_index].vertices.at(vertex) = 2;
 	chains[chain_index].num_liberties++;
+	chains[chain_index].liberty_sum += vertex;
+	chains[chain_index].liberty_square_sum += vertex * vertex;
+	update_low_liberty(chain_index);
 	return false;
 }
 
@@ -486,14 +606,18 @@ bool Board::remove_stone(uint16_t vertex) {
 	if (board[vertex] == EMPTY) {
 		return false;
 	}
+	num_stones[board[vertex] == BLACK ? 0 : 1]--;
+	toggle_hashes(vertex, board[vertex]);
 	board[vertex] = EMPTY;
+	update_eyes(vertex);
+	mark_patterns(vertex);
 	chains[chain_reps[vertex]].vertices[vertex] = 0;
 	chains[chain_reps[vertex]].num_stones--;
 	chain_reps[vertex] = 255;
 	for (int i = 0; i < 4; i++) {
 		if (valid_vertex(vertex + directions[i])) {
-			if (chain_reps[vertex + directions[i]] < chains.size()) { //we can't remove liberties unless theres a chain
-				remove_liberty(chain_reps[vertex + directions[i]], vertex); //possible bug
+			if (chain_reps[vertex + directions[i]] < chains.size()) { //the emptied point is a liberty of every adjacent chain
+				add_liberty(chain_reps[vertex + directions[i]], vertex);
 			}
 		}
 	}
@@ -511,29 +635,48 @@ bool Board::remove_liberty(uint8_t chain_index, uint16_t vertex) {
 	}
 	chains[chain_index].vertices.at(vertex) = 0;
 	chains[chain_index].num_liberties--;
+	chains[chain_index].liberty_sum -= vertex;
+	chains[chain_index].liberty_square_sum -= vertex * vertex;
+	update_low_liberty(chain_index);
 	return true;
 }
 
 void Board::capture_chain(uint16_t vertex) {
+	TRACE_SCOPE("Board::capture_chain");
 	uint8_t chain_index = chain_reps[vertex];
 	assert(chain_index < chains.size()); //TODO this assertion keeps failing
 	int side = (chains[chain_index].side == BLACK) ? 0 : 1;
 	for (int i = 0; i < num_vertices; i++) {
 		if (valid_vertex(i)) {
-			if (chains[chain_index].vertices[i]) {
+			if (chains[chain_index].vertices[i] == 1) { //2 marks a liberty, not a stone
 				remove_stone(i);
 				num_prisoners[side]++;
+				TRACE_COUNT("captured stones", 1);
 			}
 		}
 	}
 	delete_chain(chain_index);
+	flush_patterns();
 }
 
 void Board::delete_chain(uint8_t chain_index) {
+	TRACE_SCOPE("Board::delete_chain");
 	//delete &chains[chain_index];
 	assert(chain_index < chains.size());
+	int8_t list = chains[chain_index].low_list;
+	if (list >= 0) {
+		std::vector<uint8_t> &members = low_liberty[list];
+		members.erase(std::find(members.begin(), members.end(), chain_index));
+	}
 	chains.erase(chains.begin() + chain_index);
-	for (uint8_t i = 0; i < chain_reps.size(); i++) {
+	for (std::vector<uint8_t> &members : low_liberty) { //later chains move down one
+		for (uint8_t &member : members) {
+			if (member > chain_index) {
+				member--;
+			}
+		}
+	}
+	for (uint16_t i = 0; i < chain_reps.size(); i++) { //uint8_t never reaches 441 on 19x19
 		if (valid_vertex(i)) {
 			if (chain_reps[i] == chain_index) {
 				chain_reps[i] = 255;
@@ -544,6 +687,68 @@ void Board::delete_chain(uint8_t chain_index) {
 	}
 }
 
+void Board::update_low_liberty(uint8_t chain_index) {
+	Chain &chain = chains[chain_index];
+	if (chain.num_liberties == 1) {
+		mark_pattern(chain.liberty_sum); //its atari bits
+	}
+	int8_t list = -1;
+	if (chain.num_liberties == 1 || chain.num_liberties == 2) {
+		list = (chain.side ? 0 : 2) + chain.num_liberties - 1;
+	}
+	if (list == chain.low_list) {
+		return;
+	}
+	if (chain.low_list >= 0) {
+		std::vector<uint8_t> &members = low_liberty[chain.low_list];
+		members.erase(std::find(members.begin(), members.end(), chain_index));
+	}
+	if (list >= 0) {
+		low_liberty[list].push_back(chain_index);
+	}
+	chain.low_list = list;
+}
+
+const std::vector<uint8_t>& Board::get_low_liberty_chains(bool side,
+		int liberties) const {
+	assert(liberties == 1 || liberties == 2);
+	return low_liberty[(side ? 0 : 2) + liberties - 1];
+}
+
+int Board::get_chain_liberty_vertices(uint8_t chain_index, uint16_t out[2]) const {
+	//one liberty is the sum itself. for two, a + b and a^2 + b^2 give
+	//(a - b)^2 = 2 (a^2 + b^2) - (a + b)^2
+	const Chain &chain = chains[chain_index];
+	assert(chain.num_liberties <= 2);
+	if (chain.num_liberties == 1) {
+		out[0] = chain.liberty_sum;
+	} else if (chain.num_liberties == 2) {
+		int64_t sum = chain.liberty_sum;
+		int64_t square = 2 * (int64_t) chain.liberty_square_sum - sum * sum;
+		int64_t difference = (int64_t) std::lround(std::sqrt((double) square));
+		out[0] = (sum - difference) / 2;
+		out[1] = (sum + difference) / 2;
+	}
+	return chain.num_liberties;
+}
+
+uint8_t Board::get_chain_index(uint16_t vertex) const {
+	return chain_reps[vertex];
+}
+
+void Board::get_atari_moves(bool side, std::vector<int> &out) const {
+	out.clear();
+	uint16_t liberty[2];
+	for (bool colour : { !side, side }) {
+		for (uint8_t chain : get_low_liberty_chains(colour, 1)) {
+			get_chain_liberty_vertices(chain, liberty);
+			if (std::find(out.begin(), out.end(), liberty[0]) == out.end()) {
+				out.push_back(liberty[0]);
+			}
+		}
+	}
+}
+
 bool Board::is_suicide(uint16_t vertex, bool side) const { //TODO test this
 	assert(valid_vertex(vertex));
 	if (liberties(vertex) > 0) { //if liberties != 0, has liberties, not suicide
@@ -571,18 +776,36 @@ bool Board::is_suicide(uint16_t vertex, bool side) const { //TODO test this
 
 bool Board::is_eye(uint16_t vertex, bool side) const {
 	assert(valid_vertex(vertex));
-	if (get_state(vertex) != EMPTY) {
-		return false;
-	}
-	vertex_t type = side ? BLACK : WHITE;
-	vertex_t other = side ? WHITE : BLACK;
-	if (get_neighbors(vertex, type) < (4 - get_neighbors(vertex, INVAL))) {
-		return false;
-	}
+	return eyes[vertex] == (side ? BLACK_EYE : WHITE_EYE);
+}
 
-	if (get_neighbors(vertex, EMPTY) > 0) {
-		return false;
+bool Board::is_false_eye(uint16_t vertex, bool side) const {
+	assert(valid_vertex(vertex));
+	return eyes[vertex] == ((side ? BLACK_EYE : WHITE_EYE) | FALSE_EYE);
+}
+
+uint8_t Board::get_eye_status(uint16_t vertex) const {
+	return eyes[vertex];
+}
+
+uint8_t Board::classify_eye(uint16_t vertex) const {
+	if (board[vertex] != EMPTY) {
+		return NO_EYE;
 	}
+	//every orthogonal neighbor on the board has to be the same colour
+	int enclosing = EMPTY;
+	for (int i = 0; i < 4; i++) {
+		vertex_t neighbor = board[vertex + directions[i]];
+		if (neighbor == EMPTY) {
+			return NO_EYE;
+		} else if (neighbor != INVAL) {
+			if (enclosing != EMPTY && enclosing != neighbor) {
+				return NO_EYE;
+			}
+			enclosing = neighbor;
+		}
+	}
+	vertex_t other = (enclosing == BLACK) ? WHITE : BLACK;
 
 	int colorcount[4];
 
@@ -597,16 +820,11 @@ bool Board::is_eye(uint16_t vertex, bool side) const {
 	colorcount[board[vertex - 1 + (board_size + 2)]]++;
 	colorcount[board[vertex + 1 + (board_size + 2)]]++;
 
-	if (colorcount[INVAL] == 0) {
-		if (colorcount[other] > 1) {
-			return false;
-		}
-	} else {
-		if (colorcount[other]) {
-			return false;
-		}
+	//one opponent corner is allowed in the middle, none on the edge
+	if (colorcount[other] > (colorcount[INVAL] == 0 ? 1 : 0)) {
+		return enclosing | FALSE_EYE;
 	}
-	return true;
+	return enclosing; //BLACK_EYE and WHITE_EYE match BLACK and WHITE
 }
 
 int Board::get_net_prisoners() const {
@@ -626,3 +844,266 @@ int Board::get_chain_liberties(uint16_t vertex) const {
 	return chains[chain_index].num_liberties;
 }
 
+
+uint64_t Board::get_hash() const {
+	return hashes[0];
+}
+
+uint64_t Board::get_symmetric_hash(int symmetry) const {
+	return hashes[symmetry];
+}
+
+uint64_t Board::get_canonical_hash(int *symmetry) const {
+	//smallest hash of the 8, with the first symmetry that gives it
+	int best = 0;
+	for (int s = 1; s < NUM_SYMMETRIES; s++) {
+		if (hashes[s] < hashes[best]) {
+			best = s;
+		}
+	}
+	if (symmetry) {
+		*symmetry = best;
+	}
+	return hashes[best];
+}
+
+int Board::get_stone_balance() const {
+	return num_stones[0] - num_stones[1];
+}
+
+int Board::get_eye_balance() const {
+	return num_eyes[0] - num_eyes[1];
+}
+
+void Board::pass_alive(bool side, std::vector<bool> &out) const {
+	//Benson's algorithm. regions are the maximal areas without side's stones,
+	//a region is vital to a chain when all its empty points are liberties of
+	//that chain. chains with fewer than two vital regions drop out, then every
+	//region touching a dropped chain, until nothing changes
+	typedef std::array<uint64_t, 4> chain_set; //bit per chain index, 255 max
+	vertex_t colour = side ? BLACK : WHITE;
+	out.assign(num_vertices, false);
+
+	static thread_local std::vector<int16_t> region_of;
+	static thread_local std::vector<uint16_t> order; //vertices grouped by region
+	static thread_local std::vector<uint16_t> region_start;
+	static thread_local std::vector<chain_set> borders, vital;
+	static thread_local std::vector<bool> healthy, enclosed;
+	region_of.assign(num_vertices, -1);
+	order.clear();
+	region_start.clear();
+	borders.clear();
+	vital.clear();
+	healthy.clear();
+	enclosed.clear();
+
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (!valid_vertex(v) || board[v] == colour || region_of[v] >= 0) {
+			continue;
+		}
+		int region = region_start.size();
+		region_start.push_back(order.size());
+		chain_set touching = { }, all_liberties = { ~0ull, ~0ull, ~0ull, ~0ull };
+		bool every_empty_touches = true; //then the opponent has no eye to live with
+		region_of[v] = region;
+		order.push_back(v);
+		for (size_t i = region_start[region]; i < order.size(); i++) {
+			uint16_t current = order[i];
+			chain_set adjacent = { };
+			for (int d = 0; d < 4; d++) {
+				uint16_t neighbor = current + directions[d];
+				if (board[neighbor] == colour) {
+					uint8_t chain = chain_reps[neighbor];
+					adjacent[chain >> 6] |= 1ull << (chain & 63);
+				} else if (board[neighbor] != INVAL && region_of[neighbor] < 0) {
+					region_of[neighbor] = region;
+					order.push_back(neighbor);
+				}
+			}
+			for (int w = 0; w < 4; w++) {
+				touching[w] |= adjacent[w];
+				if (board[current] == EMPTY) {
+					all_liberties[w] &= adjacent[w];
+				}
+			}
+			if (board[current] == EMPTY && adjacent == chain_set { }) {
+				every_empty_touches = false;
+			}
+		}
+		for (int w = 0; w < 4; w++) {
+			all_liberties[w] &= touching[w];
+		}
+		borders.push_back(touching);
+		vital.push_back(all_liberties);
+		healthy.push_back(true);
+		enclosed.push_back(every_empty_touches);
+	}
+	region_start.push_back(order.size());
+	int num_regions = borders.size();
+
+	chain_set alive = { }; //every chain of side borders at least one region
+	for (const chain_set &touching : borders) {
+		for (int w = 0; w < 4; w++) {
+			alive[w] |= touching[w];
+		}
+	}
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		std::array<uint8_t, 256> vital_count = { };
+		for (int r = 0; r < num_regions; r++) {
+			if (!healthy[r]) {
+				continue;
+			}
+			for (int w = 0; w < 4; w++) {
+				for (uint64_t bits = vital[r][w] & alive[w]; bits; bits &= bits - 1) {
+					int chain = w * 64 + __builtin_ctzll(bits);
+					vital_count[chain] = std::min(vital_count[chain] + 1, 2);
+				}
+			}
+		}
+		for (int w = 0; w < 4; w++) {
+			for (uint64_t bits = alive[w]; bits; bits &= bits - 1) {
+				int chain = w * 64 + __builtin_ctzll(bits);
+				if (vital_count[chain] < 2) {
+					alive[w] &= ~(1ull << (chain & 63));
+					changed = true;
+				}
+			}
+		}
+		for (int r = 0; r < num_regions; r++) {
+			if (healthy[r]
+					&& ((borders[r][0] & ~alive[0]) | (borders[r][1] & ~alive[1])
+							| (borders[r][2] & ~alive[2]) | (borders[r][3] & ~alive[3]))) {
+				healthy[r] = false;
+				changed = true;
+			}
+		}
+	}
+
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (board[v] == colour) {
+			uint8_t chain = chain_reps[v];
+			out[v] = (alive[chain >> 6] >> (chain & 63)) & 1;
+		}
+	}
+	for (int r = 0; r < num_regions; r++) {
+		//regions with no bordering chain at all (an empty board) stay unsettled
+		if (healthy[r] && enclosed[r] && borders[r] != chain_set { }) {
+			for (int i = region_start[r]; i < region_start[r + 1]; i++) {
+				out[order[i]] = true;
+			}
+		}
+	}
+}
+
+void Board::update_eyes(uint16_t vertex) {
+	//a stone only changes the eye status of itself and its 8 neighbors
+	int stride = board_size + 2;
+	int area[9] = { vertex - stride - 1, vertex - stride, vertex - stride + 1,
+			vertex - 1, vertex, vertex + 1, vertex + stride - 1, vertex + stride,
+			vertex + stride + 1 };
+	for (int v : area) {
+		if (board[v] == INVAL) {
+			continue;
+		}
+		uint8_t status = classify_eye(v);
+		if (status == eyes[v]) {
+			continue;
+		}
+		if (eyes[v] == BLACK_EYE || eyes[v] == WHITE_EYE) {
+			num_eyes[eyes[v] - 1]--;
+		}
+		if (status == BLACK_EYE || status == WHITE_EYE) {
+			num_eyes[status - 1]++;
+		}
+		eyes[v] = status;
+	}
+}
+
+void Board::mark_pattern(uint16_t vertex) {
+	if (!(pattern_flags[vertex] & 1)) {
+		pattern_flags[vertex] |= 1;
+		pattern_pending.push_back(vertex);
+	}
+}
+
+void Board::mark_patterns(uint16_t vertex) {
+	int stride = board_size + 2;
+	for (int v : { vertex - stride - 1, vertex - stride, vertex - stride + 1,
+			vertex - 1, vertex + 1, vertex + stride - 1, vertex + stride,
+			vertex + stride + 1 }) {
+		if (board[v] != INVAL) {
+			mark_pattern(v);
+		}
+	}
+	mark_pattern(vertex);
+	if (!(pattern_flags[vertex] & 2)) { //listed even if its own pattern stays
+		pattern_flags[vertex] |= 2;
+		pattern_changes.push_back(vertex);
+	}
+}
+
+void Board::flush_patterns() {
+	//atari bits read the chains, which are only consistent once the
+	//operation that marked these is done
+	for (uint16_t v : pattern_pending) {
+		pattern_flags[v] &= ~1;
+		uint32_t pattern = compute_pattern(v);
+		if (pattern != patterns[v]) {
+			patterns[v] = pattern;
+			if (!(pattern_flags[v] & 2)) {
+				pattern_flags[v] |= 2;
+				pattern_changes.push_back(v);
+			}
+		}
+	}
+	pattern_pending.clear();
+}
+
+uint32_t Board::compute_pattern(uint16_t vertex) const {
+	int stride = board_size + 2;
+	const int offsets[8] = { -stride - 1, -stride, -stride + 1, -1, 1, stride
+			- 1, stride, stride + 1 };
+	uint32_t pattern = 0;
+	for (int k = 0; k < 8; k++) {
+		pattern |= (uint32_t) board[vertex + offsets[k]] << (2 * k);
+	}
+	const int orthogonal[4] = { -stride, -1, 1, stride }; //n, w, e, s
+	for (int k = 0; k < 4; k++) {
+		uint16_t neighbor = vertex + orthogonal[k];
+		if ((board[neighbor] == BLACK || board[neighbor] == WHITE)
+				&& chain_reps[neighbor] < chains.size()
+				&& chains[chain_reps[neighbor]].num_liberties == 1) {
+			pattern |= 1u << (16 + k);
+		}
+	}
+	return pattern;
+}
+
+uint32_t Board::get_pattern(uint16_t vertex) const {
+	return patterns[vertex];
+}
+
+const std::vector<uint16_t>& Board::get_pattern_changes() const {
+	return pattern_changes;
+}
+
+void Board::toggle_hashes(uint16_t vertex, vertex_t content) {
+	for (int s = 0; s < NUM_SYMMETRIES; s++) {
+		hashes[s] ^= zobrist_key(symmetries[s * num_vertices + vertex], content);
+	}
+}
+
+uint64_t Board::zobrist_key(uint16_t vertex, vertex_t content) {
+	//fixed seed so hashes are comparable between games and processes
+	static const std::vector<uint64_t> keys = [] {
+		std::mt19937_64 randGen(0x60A1);
+		std::vector<uint64_t> out(2 * NUM_VERTICES);
+		for (uint64_t &key : out) {
+			key = randGen();
+		}
+		return out;
+	}();
+	return keys[(content == BLACK ? 0 : NUM_VERTICES) + vertex];
+}
@@ -8,9 +8,11 @@
 #ifndef BOARD_H_
 #define BOARD_H_
 #include <cstdint>
+#include <string>
 #include <vector>
 #include <array>
 #include <cassert>
+#include "Symmetry.h"
 #define MAX_BOARDSIZE 19
 #define NUM_VERTICES (MAX_BOARDSIZE + 2)*(MAX_BOARDSIZE + 2)
 
@@ -21,18 +23,25 @@ public:
 	enum vertex_t : uint8_t {
 		EMPTY = 0, BLACK = 1, WHITE = 2, INVAL = 3
 	};
+	//colour of the stones enclosing an empty point, plus FALSE_EYE when the
+	//diagonals let the opponent cut it
+	enum eye_t : uint8_t {
+		NO_EYE = 0, BLACK_EYE = 1, WHITE_EYE = 2, FALSE_EYE = 4
+	};
 
 	static constexpr int PASS = -1; //vertex of pass
 	static constexpr int RESIGN = -2; //vertex of resign
 
 	uint8_t get_boardsize() const;
 
-	double area_score(double komi) const;
+	double area_score(double komi) const; //Tromp-Taylor, black minus white minus komi
+	double area_score(double komi, std::vector<int8_t> &ownership) const; //+1 black, -1 white, 0 neither
 
 	std::string move_to_text(const int16_t move) const;
 	int text_to_move(std::string move) const;
 	std::string move_to_text_sgf(int16_t move) const;
 	int text_to_move_sgf(std::string move) const;
+	int sgf_vertex(char column, char row) const; //NUM_VERTICES when off the board
 
 	uint8_t liberties(uint16_t vertex) const;
 	uint8_t liberties(uint8_t x, uint8_t y) const;
@@ -57,6 +66,11 @@ public:
 		std::vector<uint8_t> vertices;
 		int num_stones;
 		int num_liberties;
+		//sums of the liberty vertices and of their squares, which pin down
+		//the liberties of a chain with one or two
+		uint32_t liberty_sum;
+		uint32_t liberty_square_sum;
+		int8_t low_list; //index into low_liberty, -1 when in none
 	};
 
 	bool add_stone(uint8_t chain_index, uint16_t vertex);
@@ -72,11 +86,39 @@ public:
 
 	bool is_suicide(uint16_t vertex, bool side) const;
 	bool is_eye(uint16_t vertex, bool side) const;
+	bool is_false_eye(uint16_t vertex, bool side) const;
+	uint8_t get_eye_status(uint16_t vertex) const; //eye_t flags, kept up to date with every stone
+
+	//3x3 pattern around an empty vertex: the 8 neighbors' vertex_t, 2 bits each
+	//row by row from the north west, then one bit each for the north, west, east
+	//and south neighbors being in atari (bits 16-19). kept up to date with every
+	//stone, the atari bits only while the vertex is empty
+	uint32_t get_pattern(uint16_t vertex) const;
+	//vertices whose pattern or state changed with the last stone placed and its captures
+	const std::vector<uint16_t>& get_pattern_changes() const;
 
 	int get_net_prisoners() const;
 
 	int get_chain_liberties(uint16_t vertex) const;
 
+	//chains of side with exactly liberties (1 or 2) liberties, as indexes into
+	//chains. kept up to date with every stone, so no board scan is needed
+	const std::vector<uint8_t>& get_low_liberty_chains(bool side, int liberties) const;
+	int get_chain_liberty_vertices(uint8_t chain_index, uint16_t out[2]) const; //chains with at most 2
+	uint8_t get_chain_index(uint16_t vertex) const; //255 for an empty point
+	//captures of side's opponent and liberties of side's chains in atari, each once
+	void get_atari_moves(bool side, std::vector<int> &out) const;
+
+	uint64_t get_hash() const; //zobrist hash, updated on every stone change
+	uint64_t hash_after(uint16_t vertex, bool side) const; //hash once side plays at vertex
+	uint64_t get_symmetric_hash(int symmetry) const; //hash of the transformed board, see Symmetry.h
+	uint64_t get_canonical_hash(int *symmetry = nullptr) const; //same for all 8 symmetric boards
+	int get_stone_balance() const; //black stones - white stones
+	int get_eye_balance() const; //black eyes - white eyes
+
+	//marks side's pass-alive chains and the regions they settle (Benson)
+	void pass_alive(bool side, std::vector<bool> &out) const;
+
 	void print_chains() const;
 
 	virtual ~Board();
@@ -92,8 +134,31 @@ protected:
 
 	bool is_starpoint(uint16_t vertex) const;
 	std::array<uint16_t, 2> num_prisoners; //black, white
+	std::array<uint16_t, 2> num_stones; //black, white
+	std::array<int16_t, 2> num_eyes; //black, white
+	std::vector<uint8_t> eyes; //eye_t per vertex
+	std::vector<uint32_t> patterns; //get_pattern per vertex
+	std::vector<uint16_t> pattern_pending; //to recompute once the chains are consistent
+	std::vector<uint16_t> pattern_changes;
+	std::vector<uint8_t> pattern_flags; //1 pending, 2 in pattern_changes
+	//zobrist hash of the board under each symmetry, 0 being the board as it
+	//is. all 8 are updated with every stone so the canonical hash costs 8 compares
+	std::array<uint64_t, NUM_SYMMETRIES> hashes;
+	const uint16_t *symmetries; //symmetry_tables() for this size
+
+	//[0] black in atari, [1] black with two liberties, [2] and [3] white
+	std::array<std::vector<uint8_t>, 4> low_liberty;
 
 	void merge(uint16_t chain1, uint16_t chain2);
+	void update_low_liberty(uint8_t chain_index); //after its liberties change
+	void update_eyes(uint16_t vertex); //after a stone change, the 3x3 around vertex
+	uint8_t classify_eye(uint16_t vertex) const;
+	void mark_pattern(uint16_t vertex);
+	void mark_patterns(uint16_t vertex); //the 3x3 around vertex
+	void flush_patterns();
+	uint32_t compute_pattern(uint16_t vertex) const;
+	void toggle_hashes(uint16_t vertex, vertex_t content); //a stone placed or removed
+	static uint64_t zobrist_key(uint16_t vertex, vertex_t content);
 
 };
 
@@ -0,0 +1,244 @@
+/*
+ * Book.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Book.h"
+#include "Sgf.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#define BOOK_WHITE_TO_MOVE 0x9E3779B97F4A7C15ull
+
+uint64_t book_key(const Board &board, bool side, int *symmetry) {
+	return board.get_canonical_hash(symmetry) ^ (side ? 0 : BOOK_WHITE_TO_MOVE);
+}
+
+//replays archives for the builder, remembering the opening of each game
+//until its result is known
+class BookReplay: public SgfReplay {
+public:
+	BookReplay(BookBuilder &builder_) :
+			SgfReplay(nullptr), builder(builder_) {
+		set_move_callback([this](const Game &game, int move, bool side) {
+			record(game, move, side);
+		});
+	}
+
+	void game_begin() override {
+		SgfReplay::game_begin();
+		seen.clear();
+		plies = 0;
+	}
+
+	void game_end() override {
+		uint64_t before = get_games();
+		char result = get_winner();
+		SgfReplay::game_end();
+		if (get_games() > before) { //replayed to the end without trouble
+			builder.add_game(seen, result);
+		}
+	}
+private:
+	BookBuilder &builder;
+	std::vector<BookBuilder::Seen> seen;
+	int plies = 0;
+
+	void record(const Game &game, int move, bool side) {
+		const Board &board = game.get_board();
+		if (plies++ >= builder.max_plies || move == Board::PASS
+				|| board.get_boardsize() != builder.board_size) {
+			return;
+		}
+		//when the position is symmetric to itself several symmetries give
+		//the canonical hash, the move is the smallest of its images under them
+		uint64_t hashes[NUM_SYMMETRIES];
+		uint64_t canonical = ~0ull;
+		for (int s = 0; s < NUM_SYMMETRIES; s++) {
+			hashes[s] = board.get_symmetric_hash(s);
+			canonical = std::min(canonical, hashes[s]);
+		}
+		uint16_t canonical_move = UINT16_MAX;
+		for (int s = 0; s < NUM_SYMMETRIES; s++) {
+			if (hashes[s] == canonical) {
+				canonical_move = std::min(canonical_move,
+						symmetry_table(builder.board_size, s)[move]);
+			}
+		}
+		seen.push_back(
+				{ canonical ^ (side ? 0 : BOOK_WHITE_TO_MOVE), canonical_move, side });
+	}
+};
+
+BookBuilder::BookBuilder(uint8_t board_size_, int max_plies_) {
+	board_size = board_size_;
+	max_plies = max_plies_;
+	games = 0;
+}
+
+void BookBuilder::add_game(const std::vector<Seen> &seen, char winner) {
+	games++;
+	for (const Seen &item : seen) {
+		Counts &entry = counts[item.key][item.move];
+		entry.games++;
+		if (winner) {
+			bool won = (winner == 'B') == item.side;
+			entry.wins += won;
+			entry.losses += !won;
+		}
+	}
+}
+
+bool BookBuilder::add_archive(const char *begin, const char *end,
+		std::string &error) {
+	BookReplay replay(*this);
+	return sgf_parse(begin, end, replay, true, error);
+}
+
+bool BookBuilder::add_file(const std::string &path, std::string &error) {
+	MappedFile file;
+	if (!file.open(path)) {
+		error = "cannot open " + path;
+		return false;
+	}
+	return add_archive(file.data(), file.data() + file.size(), error);
+}
+
+bool BookBuilder::write(const std::string &path, uint32_t min_games) const {
+	std::vector<BookEntry> entries;
+	for (const auto &position : counts) {
+		for (const auto &move : position.second) {
+			if (move.second.games >= min_games) {
+				BookEntry entry = { position.first, move.second.games,
+						move.second.wins, move.second.losses, move.first, 0 };
+				entries.push_back(entry);
+			}
+		}
+	}
+	std::sort(entries.begin(), entries.end(),
+			[](const BookEntry &a, const BookEntry &b) {
+				if (a.key != b.key) {
+					return a.key < b.key;
+				}
+				return a.games != b.games ? a.games > b.games : a.move < b.move;
+			});
+
+	BookHeader header;
+	memcpy(header.magic, "GOBK", 4);
+	header.version = BOOK_VERSION;
+	header.board_size = board_size;
+	header.reserved = 0;
+	header.count = entries.size();
+	std::ofstream out(path, std::ios::binary);
+	out.write((const char*) &header, sizeof(header));
+	out.write((const char*) entries.data(), entries.size() * sizeof(BookEntry));
+	return (bool) out;
+}
+
+uint64_t BookBuilder::get_games() const {
+	return games;
+}
+
+size_t BookBuilder::get_positions() const {
+	size_t total = 0;
+	for (const auto &position : counts) {
+		total += position.second.size();
+	}
+	return total;
+}
+
+BookBuilder::~BookBuilder() {
+}
+
+OpeningBook::OpeningBook() {
+	entries = nullptr;
+	count = 0;
+	board_size = 0;
+}
+
+bool OpeningBook::open(const std::string &path) {
+	entries = nullptr;
+	count = 0;
+	if (!file.open(path) || file.size() < sizeof(BookHeader)) {
+		return false;
+	}
+	BookHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	if (memcmp(header.magic, "GOBK", 4) != 0 || header.version != BOOK_VERSION
+			|| header.board_size < 2 || header.board_size > MAX_BOARDSIZE
+			|| file.size() != sizeof(header) + header.count * sizeof(BookEntry)) {
+		file.close();
+		return false;
+	}
+	//the header is a multiple of 8 bytes and mappings are page aligned
+	entries = (const BookEntry*) (file.data() + sizeof(header));
+	count = header.count;
+	board_size = header.board_size;
+	return true;
+}
+
+bool OpeningBook::probe(const Game &game, bool side, int &move,
+		uint32_t min_games) const {
+	const Board &board = game.get_board();
+	if (!count || board.get_boardsize() != board_size) {
+		return false;
+	}
+	int symmetry;
+	uint64_t key = book_key(board, side, &symmetry);
+	const BookEntry *found = std::lower_bound(entries, entries + count, key,
+			[](const BookEntry &entry, uint64_t value) {
+				return entry.key < value;
+			});
+	//entries for a key are most played first
+	if (found == entries + count || found->key != key || found->games < min_games) {
+		return false;
+	}
+	move = symmetry_table(board_size, inverse_symmetry(symmetry))[found->move];
+	return true;
+}
+
+uint8_t OpeningBook::get_boardsize() const {
+	return board_size;
+}
+
+size_t OpeningBook::size() const {
+	return count;
+}
+
+OpeningBook::~OpeningBook() {
+}
+
+int book_main(int argc, char *argv[]) {
+	if (argc < 5) {
+		printf("usage: GoAI book <out.book> <boardsize> <plies> <min games> "
+				"<file.sgf>...\n");
+		return 1;
+	}
+	int size = std::stoi(argv[1]);
+	if (size < 2 || size > MAX_BOARDSIZE) {
+		printf("unsupported board size %d\n", size);
+		return 1;
+	}
+	BookBuilder builder(size, std::stoi(argv[2]));
+	for (int i = 4; i < argc; i++) {
+		std::string error;
+		if (!builder.add_file(argv[i], error)) {
+			fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+		}
+	}
+	if (!builder.write(argv[0], std::stoi(argv[3]))) {
+		printf("cannot write %s\n", argv[0]);
+		return 1;
+	}
+	OpeningBook book;
+	book.open(argv[0]);
+	printf("%llu games, %zu position/move pairs, %zu written to %s\n",
+			(unsigned long long) builder.get_games(), builder.get_positions(),
+			book.size(), argv[0]);
+	return 0;
+}
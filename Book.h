@@ -0,0 +1,99 @@
+/*
+ * Book.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef BOOK_H_
+#define BOOK_H_
+
+#include "Game.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define BOOK_VERSION 1
+
+//file layout: a BookHeader, then count BookEntry sorted by key and, within
+//a key, most played first. keys are canonical hashes (Symmetry.h) with the
+//side to move mixed in, moves are in the canonical orientation
+struct BookHeader {
+	char magic[4]; //"GOBK"
+	uint32_t version;
+	uint32_t board_size;
+	uint32_t reserved;
+	uint64_t count;
+};
+
+struct BookEntry {
+	uint64_t key;
+	uint32_t games;
+	uint32_t wins; //for the side playing the move
+	uint32_t losses;
+	uint16_t move;
+	uint16_t reserved;
+};
+
+uint64_t book_key(const Board &board, bool side, int *symmetry = nullptr);
+
+//aggregates the opening moves of SGF archives
+class BookBuilder {
+public:
+	BookBuilder(uint8_t board_size, int max_plies);
+
+	bool add_archive(const char *begin, const char *end, std::string &error);
+	bool add_file(const std::string &path, std::string &error);
+	bool write(const std::string &path, uint32_t min_games) const;
+
+	uint64_t get_games() const;
+	size_t get_positions() const; //distinct position and move pairs so far
+
+	virtual ~BookBuilder();
+private:
+	struct Counts {
+		uint32_t games;
+		uint32_t wins;
+		uint32_t losses;
+	};
+	struct Seen {
+		uint64_t key;
+		uint16_t move;
+		bool side;
+	};
+	uint8_t board_size;
+	int max_plies;
+	uint64_t games;
+	std::unordered_map<uint64_t, std::unordered_map<uint16_t, Counts>> counts;
+
+	void add_game(const std::vector<Seen> &seen, char winner);
+	friend class BookReplay;
+};
+
+//a built book, mapped read-only. probing allocates nothing
+class OpeningBook {
+public:
+	OpeningBook();
+
+	bool open(const std::string &path);
+	//the most played move from this position, in the game's own orientation
+	bool probe(const Game &game, bool side, int &move,
+			uint32_t min_games = 1) const;
+
+	uint8_t get_boardsize() const;
+	size_t size() const;
+
+	virtual ~OpeningBook();
+private:
+	MappedFile file;
+	const BookEntry *entries;
+	size_t count;
+	uint8_t board_size;
+};
+
+//"GoAI book <out.book> <boardsize> <plies> <min games> <file.sgf>..."
+int book_main(int argc, char *argv[]);
+
+#endif /* BOOK_H_ */
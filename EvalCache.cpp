@@ -0,0 +1,50 @@
+/*
+ * EvalCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "EvalCache.h"
+#include <algorithm>
+
+EvalCache::EvalCache(uint8_t size_log2) {
+	table = std::vector<Entry>(1ull << size_log2, Entry { 0, 0 });
+	mask = (1ull << size_log2) - 1;
+	probes = 0;
+	hits = 0;
+}
+
+bool EvalCache::probe(uint64_t key, double &score) {
+	probes++;
+	const Entry &entry = table[key & mask];
+	if (entry.key != key) {
+		return false;
+	}
+	hits++;
+	score = entry.score;
+	return true;
+}
+
+void EvalCache::store(uint64_t key, double score) {
+	Entry &entry = table[key & mask]; //always replace, newer leaves are more likely to repeat
+	entry.key = key;
+	entry.score = score;
+}
+
+void EvalCache::clear() {
+	std::fill(table.begin(), table.end(), Entry { 0, 0 });
+	probes = 0;
+	hits = 0;
+}
+
+uint64_t EvalCache::get_probes() const {
+	return probes;
+}
+
+uint64_t EvalCache::get_hits() const {
+	return hits;
+}
+
+EvalCache::~EvalCache() {
+}
@@ -0,0 +1,39 @@
+/*
+ * EvalCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef EVALCACHE_H_
+#define EVALCACHE_H_
+
+#include <cstdint>
+#include <vector>
+
+//direct mapped table of leaf scores, keyed by position hash
+class EvalCache {
+public:
+	EvalCache(uint8_t size_log2 = 18);
+
+	bool probe(uint64_t key, double &score);
+	void store(uint64_t key, double score);
+	void clear();
+
+	uint64_t get_probes() const;
+	uint64_t get_hits() const;
+
+	virtual ~EvalCache();
+private:
+	struct Entry {
+		uint64_t key;
+		double score;
+	};
+
+	std::vector<Entry> table;
+	uint64_t mask;
+	uint64_t probes;
+	uint64_t hits;
+};
+
+#endif /* EVALCACHE_H_ */
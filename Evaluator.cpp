@@ -0,0 +1,100 @@
+/*
+ * Evaluator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Evaluator.h"
+#include "AI.h"
+#include "NNQueue.h"
+#include <cmath>
+#include <future>
+
+#define HEURISTIC_SCALE 10.0 //points of Game::score() for a value of tanh(1)
+
+void Evaluator::evaluate_batch(Game *games, int count, Evaluation *out) {
+	for (int i = 0; i < count; i++) {
+		evaluate(games[i], out[i]);
+	}
+}
+
+bool Evaluator::has_policy() const {
+	return false;
+}
+
+uint64_t Evaluator::identity() const {
+	return 0x27BB2EE687B0B0FDull;
+}
+
+Evaluator::~Evaluator() {
+}
+
+void HeuristicEvaluator::evaluate(Game &game, Evaluation &out) {
+	out.score = ::evaluate(game);
+	out.value = std::tanh(out.score / HEURISTIC_SCALE);
+	out.policy.clear();
+}
+
+NetworkEvaluator::NetworkEvaluator(NNQueue &queue_) :
+		queue(queue_) {
+}
+
+void NetworkEvaluator::evaluate(Game &game, Evaluation &out) {
+	evaluate_batch(&game, 1, &out);
+}
+
+void NetworkEvaluator::evaluate_batch(Game *games, int count,
+		Evaluation *out) {
+	//submit everything first so the queue can put it in one batch
+	std::vector<std::future<NNQueue::Result>> results;
+	for (int i = 0; i < count; i++) {
+		results.push_back(queue.submit(games[i]));
+	}
+	for (int i = 0; i < count; i++) {
+		NNQueue::Result result = results[i].get();
+		double sign = games[i].side() ? 1 : -1; //network answers for the side to move
+		out[i].value = sign * result.value;
+		out[i].score = out[i].value;
+		out[i].policy = std::move(result.policy);
+	}
+}
+
+bool NetworkEvaluator::has_policy() const {
+	return true;
+}
+
+uint64_t NetworkEvaluator::identity() const {
+	return queue.get_fingerprint();
+}
+
+bool NetworkEvaluator::accepts(uint8_t board_size) const {
+	return board_size == queue.get_boardsize();
+}
+
+LoadedNetwork::LoadedNetwork() {
+}
+
+bool LoadedNetwork::load(const std::string &path, int batch_size) {
+	evaluator.reset();
+	queue.reset();
+	if (!network.load(path)) {
+		return false;
+	}
+	queue.reset(new NNQueue(network, batch_size));
+	evaluator.reset(new NetworkEvaluator(*queue));
+	return true;
+}
+
+NetworkEvaluator& LoadedNetwork::get_evaluator() {
+	return *evaluator;
+}
+
+uint8_t LoadedNetwork::get_boardsize() const {
+	return network.get_boardsize();
+}
+
+LoadedNetwork::~LoadedNetwork() {
+	evaluator.reset();
+	queue.reset();
+}
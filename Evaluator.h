@@ -0,0 +1,75 @@
+/*
+ * Evaluator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef EVALUATOR_H_
+#define EVALUATOR_H_
+
+#include "Game.h"
+#include "Network.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class NNQueue;
+
+struct Evaluation {
+	double score; //black's point of view, in the evaluator's own units (minimax)
+	double value; //black's point of view, in [-1, 1] (tree search)
+	std::vector<float> policy; //move priors [x * size + y], pass last. empty if none
+};
+
+//position evaluation shared by minimax and the tree search
+class Evaluator {
+public:
+	virtual void evaluate(Game &game, Evaluation &out) = 0;
+	virtual void evaluate_batch(Game *games, int count, Evaluation *out);
+	virtual bool has_policy() const;
+	//differs between evaluators whose scores differ, it is part of the
+	//transposition table key
+	virtual uint64_t identity() const;
+	virtual ~Evaluator();
+};
+
+//Game::score() through the per-thread leaf cache
+class HeuristicEvaluator: public Evaluator {
+public:
+	void evaluate(Game &game, Evaluation &out) override;
+};
+
+//policy/value network behind a batching queue. safe to share between threads.
+//the network only plays its own board size, other games get a value of 0 and
+//no policy, so front ends check accepts() first
+class NetworkEvaluator: public Evaluator {
+public:
+	NetworkEvaluator(NNQueue &queue);
+	void evaluate(Game &game, Evaluation &out) override;
+	void evaluate_batch(Game *games, int count, Evaluation *out) override;
+	bool has_policy() const override;
+	uint64_t identity() const override; //the network's fingerprint
+	bool accepts(uint8_t board_size) const;
+private:
+	NNQueue &queue;
+};
+
+//a weights file loaded together with the queue and evaluator that run it,
+//for the gtp and analyze front ends
+class LoadedNetwork {
+public:
+	LoadedNetwork();
+
+	bool load(const std::string &path, int batch_size);
+	NetworkEvaluator& get_evaluator();
+	uint8_t get_boardsize() const;
+
+	virtual ~LoadedNetwork();
+private:
+	Network network;
+	std::unique_ptr<NNQueue> queue; //stopped before network goes
+	std::unique_ptr<NetworkEvaluator> evaluator;
+};
+
+#endif /* EVALUATOR_H_ */
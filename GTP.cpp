@@ -0,0 +1,257 @@
+/*
+ * GTP.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "GTP.h"
+#include "AI.h"
+#include "MCTS.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+static const char *known_commands[] = { "protocol_version", "name", "version",
+		"known_command", "list_commands", "quit", "boardsize", "clear_board",
+		"komi", "play", "genmove", "undo", "time_settings", "time_left",
+		"final_score", "search_statistics" };
+
+GTP::GTP() {
+	board_size = MAX_BOARDSIZE;
+	komi = 7.5;
+	evaluator = nullptr;
+	playouts = 0;
+	only_size = 0;
+	new_game();
+}
+
+void GTP::set_engine(Evaluator *evaluator_, int playouts_, uint8_t board_size_) {
+	evaluator = evaluator_;
+	playouts = playouts_;
+	only_size = board_size_;
+	if (only_size && board_size != only_size) {
+		board_size = only_size;
+		new_game();
+	}
+}
+
+bool GTP::load_book(const std::string &path) {
+	return book.open(path);
+}
+
+int GTP::run(std::istream &in, std::ostream &out) {
+	std::string line;
+	while (std::getline(in, line)) {
+		if (!execute(line, out)) {
+			break;
+		}
+	}
+	return 0;
+}
+
+bool GTP::execute(std::string line, std::ostream &out) {
+	//drop comments and control characters, tabs count as spaces
+	line = line.substr(0, line.find('#'));
+	std::string clean;
+	for (char c : line) {
+		if (c == '\t') {
+			clean += ' ';
+		} else if (c >= 32 && c != 127) {
+			clean += c;
+		}
+	}
+	std::istringstream args(clean);
+	std::string id, name;
+	if (!(args >> name)) {
+		return true; //empty line
+	}
+	if (std::all_of(name.begin(), name.end(), ::isdigit)) {
+		id = name;
+		if (!(args >> name)) {
+			return true;
+		}
+	}
+
+	std::string response;
+	bool success = command(name, args, response);
+	out << (success ? "=" : "?") << id << (response.empty() ? "" : " ")
+			<< response << "\n\n" << std::flush;
+	return name != "quit";
+}
+
+bool GTP::command(const std::string &name, std::istringstream &args,
+		std::string &response) {
+	if (name == "protocol_version") {
+		response = "2";
+	} else if (name == "name") {
+		response = "GoAI";
+	} else if (name == "version") {
+		response = "1.0";
+	} else if (name == "known_command") {
+		std::string other;
+		args >> other;
+		response = std::count(std::begin(known_commands), std::end(known_commands),
+				other) ? "true" : "false";
+	} else if (name == "list_commands") {
+		for (const char *known : known_commands) {
+			response += (response.empty() ? "" : "\n") + std::string(known);
+		}
+	} else if (name == "quit") {
+	} else if (name == "boardsize") {
+		int size;
+		if (!(args >> size) || size < 2 || size > MAX_BOARDSIZE
+				|| (only_size && size != only_size)) {
+			response = "unacceptable size";
+			return false;
+		}
+		board_size = size;
+		new_game();
+	} else if (name == "clear_board") {
+		new_game();
+	} else if (name == "komi") {
+		if (!(args >> komi)) {
+			response = "syntax error";
+			return false;
+		}
+		game.set_komi(komi);
+	} else if (name == "play") {
+		std::string colour, vertex;
+		bool side;
+		if (!(args >> colour >> vertex) || !parse_colour(colour, side)) {
+			response = "syntax error";
+			return false;
+		}
+		int move = game.text_to_move(vertex);
+		if (move == NUM_VERTICES) {
+			response = "syntax error";
+			return false;
+		}
+		Game before(game);
+		if (!game.ongoing()) {
+			//cleanup phases and replayed records go on after two passes
+			game.resume();
+		}
+		to_move(side);
+		if (!game.move(move)) {
+			game = before;
+			response = "illegal move";
+			return false;
+		}
+		history.push_back(before);
+	} else if (name == "genmove") {
+		std::string colour;
+		bool side;
+		if (!(args >> colour) || !parse_colour(colour, side)) {
+			response = "syntax error";
+			return false;
+		}
+		Game before(game);
+		to_move(side);
+		int book_move = fuseki(game, book);
+		if (book_move) {
+			fprintf(stderr, "%s from the book\n", game.move_to_text(book_move).c_str());
+			game.move(book_move);
+			history.push_back(before);
+			response = game.move_to_text(book_move);
+			return true;
+		}
+		int move;
+		double seconds;
+		if (playouts > 0) {
+			auto start = std::chrono::steady_clock::now();
+			MCTS tree(evaluator ? *evaluator : heuristic);
+			move = tree.search(game, playouts);
+			seconds = std::chrono::duration<double>(
+					std::chrono::steady_clock::now() - start).count();
+			fprintf(stderr, "%s playouts %d nodes %llu %.2fs value %.2f\n",
+					game.move_to_text(move).c_str(), playouts,
+					(unsigned long long) tree.get_nodes(), seconds,
+					tree.get_root_value());
+		} else {
+			SearchLimits limits;
+			limits.seconds = clock.budget(side, board_size, game.get_play_num());
+			limits.depth = GTP_MAX_DEPTH;
+			SearchResult result = search(game, limits, evaluator);
+			fprintf(stderr, "%s depth %d nodes %llu %.2fs of %.2fs score %.1f\n",
+					game.move_to_text(result.move).c_str(), result.depth,
+					(unsigned long long) result.nodes, result.seconds, limits.seconds,
+					result.score);
+			fprintf(stderr, "search %s\n", search_result_json(result).c_str());
+			move = result.move;
+			seconds = result.seconds;
+		}
+		game.move(move);
+		clock.spend(side, seconds);
+		history.push_back(before);
+		response = game.move_to_text(move);
+	} else if (name == "undo") {
+		if (history.empty()) {
+			response = "cannot undo";
+			return false;
+		}
+		game = history.back();
+		history.pop_back();
+	} else if (name == "time_settings") {
+		double main_time, byo_time;
+		int byo_stones;
+		if (!(args >> main_time >> byo_time >> byo_stones)) {
+			response = "syntax error";
+			return false;
+		}
+		clock.set(main_time, byo_time, byo_stones);
+	} else if (name == "time_left") {
+		std::string colour;
+		bool side;
+		double seconds;
+		int stones;
+		if (!(args >> colour >> seconds >> stones) || !parse_colour(colour, side)) {
+			response = "syntax error";
+			return false;
+		}
+		clock.set_left(side, seconds, stones);
+	} else if (name == "search_statistics") {
+		response = search_threads_json(); //totals of every thread that has searched
+	} else if (name == "final_score") {
+		double score = game.final_score(komi);
+		std::ostringstream text;
+		if (score == 0) {
+			text << "0";
+		} else {
+			text << (score > 0 ? "B+" : "W+") << std::fabs(score);
+		}
+		response = text.str();
+	} else {
+		response = "unknown command";
+		return false;
+	}
+	return true;
+}
+
+bool GTP::parse_colour(const std::string &text, bool &side) const {
+	std::string lower = text;
+	std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+	if (lower == "b" || lower == "black") {
+		side = true;
+		return true;
+	} else if (lower == "w" || lower == "white") {
+		side = false;
+		return true;
+	}
+	return false;
+}
+
+void GTP::to_move(bool side) {
+	game.set_to_move(side); //a real pass would count towards ending the game
+}
+
+void GTP::new_game() {
+	game = Game(board_size);
+	game.set_komi(komi);
+	history.clear();
+	clock.reset();
+}
+
+GTP::~GTP() {
+}
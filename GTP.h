@@ -0,0 +1,59 @@
+/*
+ * GTP.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef GTP_H_
+#define GTP_H_
+
+#include "Book.h"
+#include "Evaluator.h"
+#include "Game.h"
+#include "TimeControl.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define GTP_MAX_DEPTH 32 //timed searches stop on the clock long before this
+
+//Go Text Protocol front end. genmove searches against the clock: each move
+//gets its share of the remaining time from TimeControl, unless the opening
+//book has a move for the position
+class GTP {
+public:
+	GTP();
+
+	bool load_book(const std::string &path);
+	//leaves are scored by evaluator instead of the cached Game::score(), null
+	//for that. with playouts above 0 genmove runs a tree search of that many
+	//playouts instead of minimax. a board_size other than 0 is the only size
+	//accepted, for a network trained on it
+	void set_engine(Evaluator *evaluator, int playouts, uint8_t board_size = 0);
+
+	int run(std::istream &in, std::ostream &out); //until quit or end of input
+	bool execute(std::string line, std::ostream &out); //false after quit
+
+	virtual ~GTP();
+private:
+	Game game;
+	std::vector<Game> history; //positions before each move, for undo
+	uint8_t board_size;
+	double komi;
+	TimeControl clock;
+	OpeningBook book;
+	Evaluator *evaluator;
+	HeuristicEvaluator heuristic; //the tree search's without one
+	int playouts;
+	uint8_t only_size;
+
+	bool command(const std::string &name, std::istringstream &args,
+			std::string &response);
+	bool parse_colour(const std::string &text, bool &side) const;
+	void to_move(bool side); //gives side the turn without playing a pass
+	void new_game();
+};
+
+#endif /* GTP_H_ */
@@ -7,6 +7,8 @@
 
 #include "Game.h"
 #include "Board.h"
+#include "Influence.h"
+#include "Trace.h"
 #include <random>
 #include <time.h>
 #include <inttypes.h>
@@ -18,45 +20,61 @@
 Game::Game() : Game(MAX_BOARDSIZE) {
 }
 
-Game::Game(uint8_t board_size_) {
-	goban = Board(board_size_);
+//goban is built in the initializer: a default Board is a full 19x19 one,
+//patterns and all, that would only be thrown away
+Game::Game(uint8_t board_size_) :
+		goban(board_size_) {
 	game_state = 0;
 	play_num = 0;
 	board_size = board_size_;
 	num_vertices = (board_size + 2) * (board_size + 2);
-	zobrist_table = zobristInit();
 	captured_black = 0;
 	captured_white = 0;
+	komi = 6.5;
+	pass_alive_hash = { 0, 0 };
+	pass_alive_exact = { false, false };
+	board_filter = { };
+	remember_board(goban.get_hash()); //the empty board
 }
 
-Game::Game(const Game &dupl) {
-	goban = Board(dupl.goban);
+Game::Game(const Game &dupl) :
+		goban(dupl.goban) {
 	game_state = dupl.game_state;
 	play_num = dupl.play_num;
 	board_size = dupl.board_size;
 	num_vertices = (board_size + 2) * (board_size + 2);
-	zobrist_table = dupl.zobrist_table;
 	captured_black = dupl.captured_black;
 	captured_white = dupl.captured_white;
+	komi = dupl.komi;
+	past_boards = dupl.past_boards;
+	board_filter = dupl.board_filter;
+	pass_alive = dupl.pass_alive;
+	pass_alive_hash = dupl.pass_alive_hash;
+	pass_alive_exact = dupl.pass_alive_exact;
+}
+
+Game& Game::operator=(const Game &dupl) {
+	goban = dupl.goban;
+	game_state = dupl.game_state;
+	play_num = dupl.play_num;
+	board_size = dupl.board_size;
+	num_vertices = (board_size + 2) * (board_size + 2);
+	captured_black = dupl.captured_black;
+	captured_white = dupl.captured_white;
+	komi = dupl.komi;
+	past_boards = dupl.past_boards;
+	board_filter = dupl.board_filter;
+	pass_alive = dupl.pass_alive;
+	pass_alive_hash = dupl.pass_alive_hash;
+	pass_alive_exact = dupl.pass_alive_exact;
+	return *this;
 }
 
 Game::~Game() {
 }
 
 bool Game::move(int16_t move_) {
-	if (!goban.valid_vertex(move_)) { //invalid pos
-		return false;
-	}
-	if (goban.get_state(move_) != Board::vertex_t::EMPTY) {
-		return false;
-	}
-	if (goban.is_suicide(move_, side())) {
-		return false;
-	}
-	uint32_t hashValue = zobristHash();
-	if (koCheck(hashValue)) { //if board has occurred
-		return false;
-	}
+	TRACE_SCOPE("Game::move");
 	if (game_state == 2 || game_state == -2) {
 		return false;
 	} //game over
@@ -66,33 +84,114 @@ bool Game::move(int16_t move_) {
 	}
 	if (move_ == Board::PASS) {
 		if (game_state == 1 || game_state == -1) {
-			game_state = (area_score(6.5) > 0) ? 2 : -2;
-			return true;
+			game_state = (final_score(komi) > 0) ? 2 : -2;
 		} else {
 			game_state = (side()) ? 1 : -1;
-			return true;
 		}
+		play_num++;
+		return true;
+	}
+	if (!goban.valid_vertex(move_)) { //invalid pos
+		return false;
+	}
+	if (goban.get_state(move_) != Board::vertex_t::EMPTY) {
+		return false;
+	}
+	if (goban.is_suicide(move_, side())) {
+		return false;
+	}
+	uint64_t hashValue = goban.hash_after(move_, side());
+	if (koCheck(hashValue)) { //positional superko: the result can't repeat a board
+		return false;
 	}
 
+	int own = side() ? 0 : 1;
+	if (!pass_alive[own].empty() && pass_alive[own][move_]) {
+		pass_alive[own].clear(); //filling its own settled area can undo it
+	}
+	pass_alive_exact[own] = false;
+
+	uint64_t previous = zobristHash();
 	goban.set_state(move_,
 			(side() ? Board::vertex_t::BLACK : Board::vertex_t::WHITE));
-	capture();
+	capture(move_);
+	assert(zobristHash() == hashValue);
+
+	//a move inside the opponent's pass-alive area leaves its result unchanged
+	int other = 1 - own;
+	if (pass_alive_exact[other] && pass_alive_hash[other] == previous
+			&& pass_alive[other][move_]) {
+		pass_alive_hash[other] = hashValue;
+	} else {
+		pass_alive_exact[other] = false;
+	}
 	play_num++;
-	past_boards.insert(hashValue);
+	remember_board(hashValue);
 	game_state = 0;
 	return true;
 }
 
+bool Game::setup(int vertex, bool side) {
+	//a stone placed as part of the position, not played: nothing is captured
+	//and the board it makes is where the game history starts
+	if (!goban.valid_vertex(vertex) || goban.get_state((uint16_t) vertex) != Board::EMPTY) {
+		return false;
+	}
+	goban.set_state((uint16_t) vertex,
+			side ? Board::vertex_t::BLACK : Board::vertex_t::WHITE);
+	forget_boards();
+	pass_alive = { };
+	pass_alive_exact = { false, false };
+	return true;
+}
+
+bool Game::play_quiet(int move_, bool side) {
+	//for replaying recorded games: no suicide, superko or game over checks,
+	//a second pass doesn't end anything
+	set_to_move(side);
+	if (move_ == Board::PASS) {
+		play_num++;
+		game_state = side ? 1 : -1;
+		return true;
+	}
+	if (!goban.valid_vertex(move_) || goban.get_state((uint16_t) move_) != Board::EMPTY) {
+		return false;
+	}
+	goban.set_state((uint16_t) move_,
+			side ? Board::vertex_t::BLACK : Board::vertex_t::WHITE);
+	capture(move_);
+	if (goban.get_chain_liberties(move_) == 0) {
+		goban.capture_chain(move_); //suicide, legal under some rule sets
+	}
+	pass_alive = { };
+	pass_alive_exact = { false, false };
+	play_num++;
+	remember_board(zobristHash());
+	game_state = 0;
+	return true;
+}
+
+void Game::set_to_move(bool side) {
+	if (Game::side() != side) {
+		play_num++;
+	}
+}
+
+void Game::resume() {
+	game_state = 0;
+}
+
 bool Game::move(uint8_t x, uint8_t y) {
 	int vertex = goban.get_vertex(x, y);
 	return move(vertex);
 }
 
 void Game::resign() {
-
+	move(Board::RESIGN);
 }
 
 void Game::pass() {
+	move(Board::PASS);
 }
 
 void Game::print() {
@@ -103,25 +202,19 @@ void Game::print() {
 }
 
 double Game::area_score(double komi) {
-	double score = 0;
-	for (int i = 0; i < num_vertices; i++) {
-		if (goban.valid_vertex(i)) {
-			if (goban.get_state(i) == Board::BLACK) {
-				score += 1;
-			} else if (goban.get_state(i) == Board::WHITE) {
-				score -= 1;
-			} else if (goban.is_eye(i, true)) {
-				score += 2;
-			} else if (goban.is_eye(i, false)) {
-				score -= 2;
-			}
-		}
-	}
-	return score + komi;
+	//quick estimate for evaluation: stones count 1 and eyes count 2, both kept
+	//up to date by the board. final_score is the exact count
+	return goban.get_stone_balance() + 2 * goban.get_eye_balance() + komi;
 }
 
 double Game::score() {
-	return area_score(0) + 0.1 * influence() + 2 * (goban.get_net_prisoners());
+	return score(ScoreWeights());
+}
+
+double Game::score(const ScoreWeights &weights) {
+	TRACE_SCOPE("Game::score");
+	return area_score(0) + weights.influence * influence()
+			+ weights.prisoners * goban.get_net_prisoners();
 }
 
 bool Game::side() {
@@ -136,15 +229,60 @@ bool Game::ongoing() {
 	return (game_state != 2 && game_state != -2);
 }
 
+bool Game::passed() const {
+	return (game_state == 1 || game_state == -1);
+}
+
+double Game::get_komi() const {
+	return komi;
+}
+
+void Game::set_komi(double komi_) {
+	komi = komi_;
+}
+
 Board::vertex_t Game::get_state(uint8_t x, uint8_t y) {
 	return goban.get_state(x, y);
 }
 
-/*
- std::vector<bool> Game::benson(bool side) {
+std::vector<bool> Game::benson(bool side) {
+	int index = side ? 0 : 1;
+	uint64_t hash_value = zobristHash();
+	if (!pass_alive_exact[index] || pass_alive_hash[index] != hash_value) {
+		goban.pass_alive(side, pass_alive[index]);
+		pass_alive_hash[index] = hash_value;
+		pass_alive_exact[index] = true;
+	}
+	return pass_alive[index];
+}
 
- }
- */
+bool Game::settled(int vertex) const {
+	return (!pass_alive[0].empty() && pass_alive[0][vertex])
+			|| (!pass_alive[1].empty() && pass_alive[1][vertex]);
+}
+
+double Game::final_score(double komi) {
+	static thread_local std::vector<int8_t> ownership;
+	return final_score(komi, ownership);
+}
+
+double Game::final_score(double komi, std::vector<int8_t> &ownership) {
+	//Tromp-Taylor area, except that pass-alive areas go to their owner even
+	//when they still hold dead stones
+	goban.area_score(0, ownership);
+	std::vector<bool> black = benson(true);
+	std::vector<bool> white = benson(false);
+	int total = 0;
+	for (uint16_t v = 0; v < num_vertices; v++) {
+		if (black[v]) {
+			ownership[v] = 1;
+		} else if (white[v]) {
+			ownership[v] = -1;
+		}
+		total += ownership[v];
+	}
+	return total - komi;
+}
 
 uint8_t Game::get_neighbors(uint8_t x, uint8_t y, Board::vertex_t content) {
 	return goban.get_neighbors(goban.get_vertex(x, y), content);
@@ -179,34 +317,58 @@ void Game::simulate_sgf(std::vector<std::string> movelist) {
 	}
 }
 
-bool Game::koCheck(uint32_t hash_value) {
-	return (past_boards.find(hash_value) != past_boards.end());
+void Game::remember_board(uint64_t hash) {
+	past_boards.push_back(hash);
+	board_filter[hash >> 59] |= 1ull << ((hash >> 53) & 63);
 }
 
-uint32_t Game::zobristHash() {
-	uint32_t hashValue = 0;
-	for (int i = 0; i < board_size; i++) {
-		for (int j = 0; j < board_size; j++) {
-			Board::vertex_t state = goban.get_state(i, j);
-			if (state == Board::vertex_t::BLACK) {
-				hashValue ^= zobrist_table[i * board_size + j];
-			} else if (state == Board::vertex_t::WHITE) {
-				hashValue ^=
-						zobrist_table[i * board_size + j + board_size * board_size]; //two sets of values
-			}
-		}
+void Game::forget_boards() {
+	past_boards.clear();
+	board_filter = { };
+	remember_board(zobristHash());
+}
+
+bool Game::koCheck(uint64_t hash_value) {
+	if (!(board_filter[hash_value >> 59] & (1ull << ((hash_value >> 53) & 63)))) {
+		return false; //never seen
+	}
+	return std::find(past_boards.begin(), past_boards.end(), hash_value)
+			!= past_boards.end();
+}
+
+int Game::get_board_index() const {
+	return (int) past_boards.size() - 1;
+}
+
+int Game::repeated_board(int move_) {
+	if (!goban.valid_vertex(move_) || goban.get_state((uint16_t) move_) != Board::EMPTY
+			|| goban.is_suicide(move_, side())) {
+		return -1;
 	}
-	return hashValue; /*maybe unnecessary, I could have an attribute representing the hash of
-	 the current board and update that each time a new move is made
-	 unless it is a capturing move */
+	uint64_t hash = goban.hash_after(move_, side());
+	if (!koCheck(hash)) {
+		return -1;
+	}
+	auto found = std::find(past_boards.begin(), past_boards.end(), hash);
+	return (found == past_boards.end()) ? -1 : (int) (found - past_boards.begin());
+}
+
+uint64_t Game::zobristHash() const {
+	return goban.get_hash(); //the board updates the hash as stones are placed and captured
 }
 
-bool Game::capture() {
-	for (int i = 0; i < num_vertices; i++) {
-		if (goban.valid_vertex(i)) {
-			if (goban.get_state(i) != Board::EMPTY) {
-				if (goban.get_chain_liberties(i) == 0) {
-					goban.capture_chain(i); //TODO problems here
+bool Game::capture(uint16_t vertex) {
+	TRACE_SCOPE("Game::capture");
+	//only chains touching the new stone can have lost their last liberty
+	for (int i = 0; i < 4; i++) {
+		int neighbor = vertex + goban.directions[i];
+		if (goban.valid_vertex(neighbor)) {
+			//only the opponent's chains: the new stone's own chain is at zero
+			//liberties until the opponent chain it takes away is removed
+			if (goban.get_state(neighbor) != Board::EMPTY
+					&& goban.get_state(neighbor) != goban.get_state(vertex)) {
+				if (goban.get_chain_liberties(neighbor) == 0) {
+					goban.capture_chain(neighbor);
 				}
 			}
 		}
@@ -214,75 +376,17 @@ bool Game::capture() {
 	return true;
 }
 
-std::vector<uint32_t> Game::zobristInit() {
-	std::mt19937_64 randGen = std::mt19937_64(time(NULL)); //random number generator
-	std::vector<uint32_t> out;
-	for (int i = 0; i < board_size * board_size * 2; i++) {
-		out.push_back(randGen());
-	}
-	return out;
-}
-
 int Game::get_prisoners() {
 	return goban.get_net_prisoners();
 }
 
-double Game::influence() {
-	if (play_num == 0) {
-		return 0.f;
-	}
-	int directions[4] = { -1, -board_size, 1, board_size };
-	std::vector<double> infl = std::vector<double>((board_size * board_size), 0);
-	for (int i = 0; i < (board_size * board_size); i++) {
-		switch (get_state(i / board_size, i % board_size)) {
-			case Board::vertex_t::BLACK:
-				infl[i] = 1;
-				break;
-			case Board::vertex_t::WHITE:
-				infl[i] = -1;
-				break;
-			default:
-				infl[i] = 0;
-				break;
-		}
-	}
+const Board& Game::get_board() const {
+	return goban;
+}
 
-	for (int i = 0; i < 3; i++) {
-		for (int j = 0; j < (board_size * board_size); j++) {
-			double sum = 0;
-			if (infl[j] == 0) {
-				for (int d = 0; d < 4; d++) {
-					if (j + directions[d] >= 0
-							&& j + directions[d] < (board_size * board_size)) {
-						sum += (infl[j + directions[d]]);
-					}
-				}
-				if (sum < 2.f && sum > -2.f) {
-					infl[j] += sum / 2;
-				}
-			}
-		}
-	}
-	double out = 0;
-	for (int i = 0; i < (board_size * board_size); i++) {
-		if (infl[i] == 0.0) {
-			//printf("  ");
-		} else if (infl[i] == 1.0) {
-			//printf(" O");
-		} else if (infl[i] == -1.0) {
-			//printf(" X");
-		} else if (infl[i] > 0) {
-			//printf(" o");
-		} else if (infl[i] < 0) {
-			//printf(" x");
-		}
-		//printf("%6.2f ", infl[i]);
-		if (i % board_size == (board_size - 1)) {
-			//printf("\n");
-		}
-		out += infl[i];
-	}
-	return out;
+double Game::influence() {
+	TRACE_SCOPE("Game::influence");
+	return bouzy_influence(goban); //padded int16 grid, see Influence.cpp
 }
 
 bool Game::is_eye(int vertex, bool side) {
@@ -311,7 +415,7 @@ int Game::text_to_move(std::string move) const {
 	parsestream >> row;
 	--row;
 
-	if (row > board_size * board_size || column > board_size * board_size) {
+	if (row < 0 || row >= board_size || column >= board_size) {
 		return NUM_VERTICES;
 	}
 	return get_vertex(row, column);
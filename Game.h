@@ -8,29 +8,47 @@
 #ifndef GAME_H
 #define GAME_H
 #include "Board.h"
-#include <unordered_set>
+#include <array>
 #include <functional>
 
+//weights of the influence and prisoner terms of Game::score()
+struct ScoreWeights {
+	double influence = 0.1;
+	double prisoners = 2;
+};
+
 class Game {
 public:
 	Game();
 	Game(uint8_t board_size);
 	Game(const Game &dupl);
+	Game& operator=(const Game &dupl);
 	virtual ~Game();
 
 	bool move(int16_t move_);
 	bool move(uint8_t x, uint8_t y);
+	bool setup(int vertex, bool side); //places a stone of a given position
+	void set_to_move(bool side);
+	void resume(); //a game ended by passes or resignation takes moves again
+	bool play_quiet(int move_, bool side); //recorded moves, only checked for an empty point
 	void resign();
 	void pass();
 
 	void print();
 	double area_score(double komi);
 	double score();
+	double score(const ScoreWeights &weights);
 	bool side();
 	uint8_t get_size();
 	bool ongoing();
+	bool passed() const; //the last move was a pass
+	double get_komi() const;
+	void set_komi(double komi);
 	Board::vertex_t get_state(uint8_t x, uint8_t y);
-	std::vector<bool> benson(bool side);
+	std::vector<bool> benson(bool side); //pass-alive stones and territory of side
+	bool settled(int vertex) const; //inside either side's pass-alive area
+	double final_score(double komi); //black minus white minus komi
+	double final_score(double komi, std::vector<int8_t> &ownership);
 	uint8_t get_neighbors(uint8_t x, uint8_t y, Board::vertex_t content);
 	bool relevant(uint8_t x, uint8_t y);
 	int get_vertex(uint8_t x, uint8_t y) const;
@@ -43,27 +61,43 @@ public:
 	std::string move_to_text(const int move) const;
 
 	int get_play_num() const;
+	int get_board_index() const; //position of the current board in the superko history
+	int repeated_board(int move_); //history index of the board move_ would repeat, -1 if none
 
-	uint32_t zobristHash();
+	uint64_t zobristHash() const;
 
 	int get_prisoners();
+	const Board& get_board() const;
 
 	void debug();
 
 private:
 	Board goban;
-	bool koCheck(uint32_t hashValue);
-	std::unordered_set<uint32_t> past_boards;
-	std::vector<uint32_t> zobrist_table;
+	bool koCheck(uint64_t hashValue);
+	//every board so far, for superko. exact hashes, a rotated board is no
+	//repeat. a vector copies 50-150 times faster than a hash set of 50-300
+	//boards, and search copies a Game for every child
+	std::vector<uint64_t> past_boards;
+	//bit hash >> 53 of every board in past_boards. a clear bit rules a board
+	//out without scanning the history, which is the usual case
+	std::array<uint64_t, 32> board_filter;
+	void remember_board(uint64_t hash);
+	void forget_boards(); //all but the current one
 	int8_t game_state; //0 is ongoing game, +-1 is pass, +-2 is resign, black is + white is -
 	uint16_t play_num;
+	double komi; //used to decide the game after two passes
 	uint8_t board_size;
 	uint16_t num_vertices;
-	bool capture(); //captures all stones surrounded, returns false if self capture
-	std::vector<uint32_t> zobristInit();
+	bool capture(uint16_t vertex); //captures the chains around vertex left without liberties
 	double influence();
 	uint16_t captured_black;
 	uint16_t captured_white;
+	//last Benson result per side (black, white). a pass-alive area stays
+	//pass-alive whatever the opponent plays, so the masks remain a valid lower
+	//bound after moves and are exact while the hash still matches
+	std::array<std::vector<bool>, 2> pass_alive;
+	std::array<uint64_t, 2> pass_alive_hash;
+	std::array<bool, 2> pass_alive_exact;
 };
 
 #endif // GAME_H
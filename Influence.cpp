@@ -0,0 +1,301 @@
+/*
+ * Influence.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Influence.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define INFLUENCE_X86
+#endif
+
+#define INFLUENCE_CELLS (INFLUENCE_ROWS * INFLUENCE_STRIDE)
+#define DILATIONS 5
+#define EROSIONS 21
+
+//the board's padded row r is stored in grid row r + 1, so every kernel can
+//read one row above and below the board edge without bounds checks
+struct InfluenceGrid {
+	alignas(32) int16_t cells[INFLUENCE_CELLS];
+};
+
+struct InfluenceTables {
+	alignas(32) int16_t mask[INFLUENCE_CELLS]; //-1 on the board, 0 elsewhere
+	alignas(32) int16_t degree[INFLUENCE_CELLS]; //neighbors on the board
+};
+
+static const InfluenceTables& influence_tables(uint8_t board_size) {
+	static const std::vector<InfluenceTables> all = [] {
+		std::vector<InfluenceTables> out(MAX_BOARDSIZE + 1);
+		for (int size = 1; size <= MAX_BOARDSIZE; size++) {
+			InfluenceTables &t = out[size];
+			std::fill(std::begin(t.mask), std::end(t.mask), 0);
+			std::fill(std::begin(t.degree), std::end(t.degree), 0);
+			for (int r = 2; r <= size + 1; r++) {
+				for (int c = 1; c <= size; c++) {
+					t.mask[r * INFLUENCE_STRIDE + c] = -1;
+				}
+			}
+			for (int p = INFLUENCE_STRIDE; p < INFLUENCE_CELLS - INFLUENCE_STRIDE; p++) {
+				if (t.mask[p]) {
+					t.degree[p] = -(t.mask[p - 1] + t.mask[p + 1]
+							+ t.mask[p - INFLUENCE_STRIDE] + t.mask[p + INFLUENCE_STRIDE]);
+				}
+			}
+		}
+		return out;
+	}();
+	return all[board_size];
+}
+
+/*
+ * dilation: a point not touching the other colour grows by the number of
+ * neighbors of its own colour. erosion: a point shrinks towards 0 by the
+ * number of on-board neighbors that are not of its colour.
+ */
+
+static void dilate_scalar(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	for (int p = first; p < last; p++) {
+		int v = src[p];
+		int l = src[p - 1], r = src[p + 1];
+		int u = src[p - INFLUENCE_STRIDE], d = src[p + INFLUENCE_STRIDE];
+		int pos = (l > 0) + (r > 0) + (u > 0) + (d > 0);
+		int neg = (l < 0) + (r < 0) + (u < 0) + (d < 0);
+		if (v >= 0 && neg == 0) {
+			v += pos;
+		} else if (v <= 0 && pos == 0) {
+			v -= neg;
+		}
+		dst[p] = v & t.mask[p];
+	}
+}
+
+static void erode_scalar(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	for (int p = first; p < last; p++) {
+		int v = src[p];
+		int l = src[p - 1], r = src[p + 1];
+		int u = src[p - INFLUENCE_STRIDE], d = src[p + INFLUENCE_STRIDE];
+		if (v > 0) {
+			int pos = (l > 0) + (r > 0) + (u > 0) + (d > 0);
+			v = std::max(v - (t.degree[p] - pos), 0);
+		} else if (v < 0) {
+			int neg = (l < 0) + (r < 0) + (u < 0) + (d < 0);
+			v = std::min(v + (t.degree[p] - neg), 0);
+		}
+		dst[p] = v & t.mask[p];
+	}
+}
+
+#ifdef INFLUENCE_X86
+
+__attribute__((target("sse2")))
+static void dilate_sse2(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	const __m128i zero = _mm_setzero_si128();
+	for (int p = first; p < last; p += 8) {
+		__m128i v = _mm_load_si128((const __m128i*) (src + p));
+		__m128i l = _mm_loadu_si128((const __m128i*) (src + p - 1));
+		__m128i r = _mm_loadu_si128((const __m128i*) (src + p + 1));
+		__m128i u = _mm_load_si128((const __m128i*) (src + p - INFLUENCE_STRIDE));
+		__m128i d = _mm_load_si128((const __m128i*) (src + p + INFLUENCE_STRIDE));
+		//comparisons give -1 per true lane, so the sums are negated counts
+		__m128i pos = _mm_add_epi16(
+				_mm_add_epi16(_mm_cmpgt_epi16(l, zero), _mm_cmpgt_epi16(r, zero)),
+				_mm_add_epi16(_mm_cmpgt_epi16(u, zero), _mm_cmpgt_epi16(d, zero)));
+		__m128i neg = _mm_add_epi16(
+				_mm_add_epi16(_mm_cmplt_epi16(l, zero), _mm_cmplt_epi16(r, zero)),
+				_mm_add_epi16(_mm_cmplt_epi16(u, zero), _mm_cmplt_epi16(d, zero)));
+		__m128i grow = _mm_andnot_si128(_mm_cmplt_epi16(v, zero),
+				_mm_cmpeq_epi16(neg, zero));
+		__m128i shrink = _mm_andnot_si128(_mm_cmpgt_epi16(v, zero),
+				_mm_cmpeq_epi16(pos, zero));
+		v = _mm_sub_epi16(v, _mm_and_si128(grow, pos));
+		v = _mm_add_epi16(v, _mm_andnot_si128(grow, _mm_and_si128(shrink, neg)));
+		v = _mm_and_si128(v, _mm_load_si128((const __m128i*) (t.mask + p)));
+		_mm_store_si128((__m128i*) (dst + p), v);
+	}
+}
+
+__attribute__((target("sse2")))
+static void erode_sse2(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	const __m128i zero = _mm_setzero_si128();
+	for (int p = first; p < last; p += 8) {
+		__m128i v = _mm_load_si128((const __m128i*) (src + p));
+		__m128i l = _mm_loadu_si128((const __m128i*) (src + p - 1));
+		__m128i r = _mm_loadu_si128((const __m128i*) (src + p + 1));
+		__m128i u = _mm_load_si128((const __m128i*) (src + p - INFLUENCE_STRIDE));
+		__m128i d = _mm_load_si128((const __m128i*) (src + p + INFLUENCE_STRIDE));
+		__m128i degree = _mm_load_si128((const __m128i*) (t.degree + p));
+		__m128i pos = _mm_add_epi16(
+				_mm_add_epi16(_mm_cmpgt_epi16(l, zero), _mm_cmpgt_epi16(r, zero)),
+				_mm_add_epi16(_mm_cmpgt_epi16(u, zero), _mm_cmpgt_epi16(d, zero)));
+		__m128i neg = _mm_add_epi16(
+				_mm_add_epi16(_mm_cmplt_epi16(l, zero), _mm_cmplt_epi16(r, zero)),
+				_mm_add_epi16(_mm_cmplt_epi16(u, zero), _mm_cmplt_epi16(d, zero)));
+		//v - (degree - pos) and v + (degree - neg), with pos and neg negated
+		__m128i down = _mm_max_epi16(
+				_mm_sub_epi16(v, _mm_add_epi16(degree, pos)), zero);
+		__m128i up = _mm_min_epi16(
+				_mm_add_epi16(v, _mm_add_epi16(degree, neg)), zero);
+		v = _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi16(v, zero), down),
+				_mm_and_si128(_mm_cmplt_epi16(v, zero), up));
+		v = _mm_and_si128(v, _mm_load_si128((const __m128i*) (t.mask + p)));
+		_mm_store_si128((__m128i*) (dst + p), v);
+	}
+}
+
+__attribute__((target("avx2")))
+static void dilate_avx2(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	const __m256i zero = _mm256_setzero_si256();
+	for (int p = first; p < last; p += 16) {
+		__m256i v = _mm256_load_si256((const __m256i*) (src + p));
+		__m256i l = _mm256_loadu_si256((const __m256i*) (src + p - 1));
+		__m256i r = _mm256_loadu_si256((const __m256i*) (src + p + 1));
+		__m256i u = _mm256_load_si256((const __m256i*) (src + p - INFLUENCE_STRIDE));
+		__m256i d = _mm256_load_si256((const __m256i*) (src + p + INFLUENCE_STRIDE));
+		__m256i pos = _mm256_add_epi16(
+				_mm256_add_epi16(_mm256_cmpgt_epi16(l, zero),
+						_mm256_cmpgt_epi16(r, zero)),
+				_mm256_add_epi16(_mm256_cmpgt_epi16(u, zero),
+						_mm256_cmpgt_epi16(d, zero)));
+		__m256i neg = _mm256_add_epi16(
+				_mm256_add_epi16(_mm256_cmpgt_epi16(zero, l),
+						_mm256_cmpgt_epi16(zero, r)),
+				_mm256_add_epi16(_mm256_cmpgt_epi16(zero, u),
+						_mm256_cmpgt_epi16(zero, d)));
+		__m256i grow = _mm256_andnot_si256(_mm256_cmpgt_epi16(zero, v),
+				_mm256_cmpeq_epi16(neg, zero));
+		__m256i shrink = _mm256_andnot_si256(_mm256_cmpgt_epi16(v, zero),
+				_mm256_cmpeq_epi16(pos, zero));
+		v = _mm256_sub_epi16(v, _mm256_and_si256(grow, pos));
+		v = _mm256_add_epi16(v,
+				_mm256_andnot_si256(grow, _mm256_and_si256(shrink, neg)));
+		v = _mm256_and_si256(v, _mm256_load_si256((const __m256i*) (t.mask + p)));
+		_mm256_store_si256((__m256i*) (dst + p), v);
+	}
+}
+
+__attribute__((target("avx2")))
+static void erode_avx2(const int16_t *src, int16_t *dst,
+		const InfluenceTables &t, int first, int last) {
+	const __m256i zero = _mm256_setzero_si256();
+	for (int p = first; p < last; p += 16) {
+		__m256i v = _mm256_load_si256((const __m256i*) (src + p));
+		__m256i l = _mm256_loadu_si256((const __m256i*) (src + p - 1));
+		__m256i r = _mm256_loadu_si256((const __m256i*) (src + p + 1));
+		__m256i u = _mm256_load_si256((const __m256i*) (src + p - INFLUENCE_STRIDE));
+		__m256i d = _mm256_load_si256((const __m256i*) (src + p + INFLUENCE_STRIDE));
+		__m256i degree = _mm256_load_si256((const __m256i*) (t.degree + p));
+		__m256i pos = _mm256_add_epi16(
+				_mm256_add_epi16(_mm256_cmpgt_epi16(l, zero),
+						_mm256_cmpgt_epi16(r, zero)),
+				_mm256_add_epi16(_mm256_cmpgt_epi16(u, zero),
+						_mm256_cmpgt_epi16(d, zero)));
+		__m256i neg = _mm256_add_epi16(
+				_mm256_add_epi16(_mm256_cmpgt_epi16(zero, l),
+						_mm256_cmpgt_epi16(zero, r)),
+				_mm256_add_epi16(_mm256_cmpgt_epi16(zero, u),
+						_mm256_cmpgt_epi16(zero, d)));
+		__m256i down = _mm256_max_epi16(
+				_mm256_sub_epi16(v, _mm256_add_epi16(degree, pos)), zero);
+		__m256i up = _mm256_min_epi16(
+				_mm256_add_epi16(v, _mm256_add_epi16(degree, neg)), zero);
+		v = _mm256_or_si256(_mm256_and_si256(_mm256_cmpgt_epi16(v, zero), down),
+				_mm256_and_si256(_mm256_cmpgt_epi16(zero, v), up));
+		v = _mm256_and_si256(v, _mm256_load_si256((const __m256i*) (t.mask + p)));
+		_mm256_store_si256((__m256i*) (dst + p), v);
+	}
+}
+
+#endif
+
+bool influence_path_supported(influence_path_t path) {
+	switch (path) {
+		case INFLUENCE_SCALAR:
+			return true;
+#ifdef INFLUENCE_X86
+		case INFLUENCE_SSE2:
+			return __builtin_cpu_supports("sse2");
+		case INFLUENCE_AVX2:
+			return __builtin_cpu_supports("avx2");
+#endif
+		default:
+			return false;
+	}
+}
+
+const char* influence_path_name(influence_path_t path) {
+	switch (path) {
+		case INFLUENCE_SCALAR:
+			return "scalar";
+		case INFLUENCE_SSE2:
+			return "sse2";
+		case INFLUENCE_AVX2:
+			return "avx2";
+	}
+	return "unknown";
+}
+
+int bouzy_influence(const Board &board) {
+	static const influence_path_t best =
+			influence_path_supported(INFLUENCE_AVX2) ? INFLUENCE_AVX2 :
+			influence_path_supported(INFLUENCE_SSE2) ?
+					INFLUENCE_SSE2 : INFLUENCE_SCALAR;
+	return bouzy_influence(board, best);
+}
+
+int bouzy_influence(const Board &board, influence_path_t path) {
+	uint8_t size = board.get_boardsize();
+	const InfluenceTables &t = influence_tables(size);
+	InfluenceGrid grids[2];
+	std::fill(std::begin(grids[0].cells), std::end(grids[0].cells), 0);
+	std::fill(std::begin(grids[1].cells), std::end(grids[1].cells), 0);
+	for (int x = 0; x < size; x++) {
+		int16_t *row = grids[0].cells + (x + 2) * INFLUENCE_STRIDE + 1;
+		for (int y = 0; y < size; y++) {
+			Board::vertex_t state = board.get_state((uint8_t) x, (uint8_t) y);
+			row[y] = (state == Board::BLACK) ? 128 : (state == Board::WHITE) ? -128 : 0;
+		}
+	}
+
+	//whole padded rows are processed, the mask clears everything off the board
+	int first = 2 * INFLUENCE_STRIDE;
+	int last = (size + 2) * INFLUENCE_STRIDE;
+	void (*dilate)(const int16_t*, int16_t*, const InfluenceTables&, int, int) =
+			dilate_scalar;
+	void (*erode)(const int16_t*, int16_t*, const InfluenceTables&, int, int) =
+			erode_scalar;
+#ifdef INFLUENCE_X86
+	if (path == INFLUENCE_SSE2) {
+		dilate = dilate_sse2;
+		erode = erode_sse2;
+	} else if (path == INFLUENCE_AVX2) {
+		dilate = dilate_avx2;
+		erode = erode_avx2;
+	}
+#endif
+	int current = 0;
+	for (int i = 0; i < DILATIONS; i++) {
+		dilate(grids[current].cells, grids[1 - current].cells, t, first, last);
+		current = 1 - current;
+	}
+	for (int i = 0; i < EROSIONS; i++) {
+		erode(grids[current].cells, grids[1 - current].cells, t, first, last);
+		current = 1 - current;
+	}
+
+	int out = 0;
+	for (int p = first; p < last; p++) {
+		out += (grids[current].cells[p] > 0) - (grids[current].cells[p] < 0);
+	}
+	return out;
+}
@@ -0,0 +1,29 @@
+/*
+ * Influence.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef INFLUENCE_H_
+#define INFLUENCE_H_
+
+#include "Board.h"
+#include <cstdint>
+
+#define INFLUENCE_STRIDE 32 //one padded board row, 2 AVX2 or 4 SSE registers of int16
+#define INFLUENCE_ROWS (MAX_BOARDSIZE + 4) //board rows, edges and a guard row on each side
+
+//Bouzy 5/21 territory estimate: stones start at +-128, then 5 dilations and
+//21 erosions. returns points leaning black - points leaning white
+int bouzy_influence(const Board &board);
+
+//the kernels behind bouzy_influence, exposed so they can be checked against each other
+enum influence_path_t {
+	INFLUENCE_SCALAR, INFLUENCE_SSE2, INFLUENCE_AVX2
+};
+bool influence_path_supported(influence_path_t path);
+int bouzy_influence(const Board &board, influence_path_t path);
+const char* influence_path_name(influence_path_t path);
+
+#endif /* INFLUENCE_H_ */
@@ -0,0 +1,233 @@
+/*
+ * Json.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+const JsonValue* JsonValue::get(const std::string &key) const {
+	for (const std::pair<std::string, JsonValue> &member : members) {
+		if (member.first == key) {
+			return &member.second;
+		}
+	}
+	return nullptr;
+}
+
+//recursive descent over the text, pos is the next unread character
+static bool parse_value(const std::string &text, size_t &pos, JsonValue &out,
+		int depth);
+
+static void skip_space(const std::string &text, size_t &pos) {
+	while (pos < text.size() && strchr(" \t\r\n", text[pos])) {
+		pos++;
+	}
+}
+
+static bool parse_string(const std::string &text, size_t &pos,
+		std::string &out) {
+	if (pos >= text.size() || text[pos] != '"') {
+		return false;
+	}
+	pos++;
+	out.clear();
+	while (pos < text.size() && text[pos] != '"') {
+		char c = text[pos++];
+		if (c != '\\') {
+			out += c;
+			continue;
+		}
+		if (pos >= text.size()) {
+			return false;
+		}
+		c = text[pos++];
+		switch (c) {
+		case 'n':
+			out += '\n';
+			break;
+		case 't':
+			out += '\t';
+			break;
+		case 'r':
+			out += '\r';
+			break;
+		case 'b':
+			out += '\b';
+			break;
+		case 'f':
+			out += '\f';
+			break;
+		case 'u': {
+			if (pos + 4 > text.size()) {
+				return false;
+			}
+			unsigned code = strtoul(text.substr(pos, 4).c_str(), nullptr, 16);
+			pos += 4;
+			if (code < 0x80) {
+				out += (char) code;
+			} else if (code < 0x800) {
+				out += (char) (0xC0 | (code >> 6));
+				out += (char) (0x80 | (code & 0x3F));
+			} else {
+				out += (char) (0xE0 | (code >> 12));
+				out += (char) (0x80 | ((code >> 6) & 0x3F));
+				out += (char) (0x80 | (code & 0x3F));
+			}
+			break;
+		}
+		default:
+			out += c; //quote, backslash and slash stand for themselves
+		}
+	}
+	if (pos >= text.size()) {
+		return false;
+	}
+	pos++;
+	return true;
+}
+
+static bool parse_value(const std::string &text, size_t &pos, JsonValue &out,
+		int depth) {
+	if (depth > 64) {
+		return false;
+	}
+	skip_space(text, pos);
+	if (pos >= text.size()) {
+		return false;
+	}
+	char c = text[pos];
+	if (c == '{') {
+		out.type = JsonValue::OBJECT;
+		pos++;
+		skip_space(text, pos);
+		if (pos < text.size() && text[pos] == '}') {
+			pos++;
+			return true;
+		}
+		while (true) {
+			std::string key;
+			skip_space(text, pos);
+			if (!parse_string(text, pos, key)) {
+				return false;
+			}
+			skip_space(text, pos);
+			if (pos >= text.size() || text[pos++] != ':') {
+				return false;
+			}
+			out.members.emplace_back(key, JsonValue());
+			if (!parse_value(text, pos, out.members.back().second, depth + 1)) {
+				return false;
+			}
+			skip_space(text, pos);
+			if (pos < text.size() && text[pos] == ',') {
+				pos++;
+			} else if (pos < text.size() && text[pos] == '}') {
+				pos++;
+				return true;
+			} else {
+				return false;
+			}
+		}
+	} else if (c == '[') {
+		out.type = JsonValue::ARRAY;
+		pos++;
+		skip_space(text, pos);
+		if (pos < text.size() && text[pos] == ']') {
+			pos++;
+			return true;
+		}
+		while (true) {
+			out.items.emplace_back();
+			if (!parse_value(text, pos, out.items.back(), depth + 1)) {
+				return false;
+			}
+			skip_space(text, pos);
+			if (pos < text.size() && text[pos] == ',') {
+				pos++;
+			} else if (pos < text.size() && text[pos] == ']') {
+				pos++;
+				return true;
+			} else {
+				return false;
+			}
+		}
+	} else if (c == '"') {
+		out.type = JsonValue::STRING;
+		return parse_string(text, pos, out.text);
+	} else if (text.compare(pos, 4, "true") == 0) {
+		out.type = JsonValue::BOOL;
+		out.boolean = true;
+		pos += 4;
+		return true;
+	} else if (text.compare(pos, 5, "false") == 0) {
+		out.type = JsonValue::BOOL;
+		pos += 5;
+		return true;
+	} else if (text.compare(pos, 4, "null") == 0) {
+		out.type = JsonValue::NUL;
+		pos += 4;
+		return true;
+	}
+	const char *start = text.c_str() + pos;
+	char *end;
+	out.number = strtod(start, &end);
+	if (end == start) {
+		return false;
+	}
+	out.type = JsonValue::NUMBER;
+	out.text.assign(start, end - start); //as written, so ids echo back unchanged
+	pos += end - start;
+	return true;
+}
+
+bool json_parse(const std::string &text, JsonValue &out, std::string &error) {
+	size_t pos = 0;
+	out = JsonValue();
+	if (!parse_value(text, pos, out, 0)) {
+		error = "malformed JSON near character " + std::to_string(pos);
+		return false;
+	}
+	skip_space(text, pos);
+	if (pos != text.size()) {
+		error = "trailing characters after JSON value";
+		return false;
+	}
+	return true;
+}
+
+std::string json_quote(const std::string &text) {
+	std::string out = "\"";
+	for (char c : text) {
+		switch (c) {
+		case '"':
+			out += "\\\"";
+			break;
+		case '\\':
+			out += "\\\\";
+			break;
+		case '\n':
+			out += "\\n";
+			break;
+		case '\t':
+			out += "\\t";
+			break;
+		case '\r':
+			out += "\\r";
+			break;
+		default:
+			if ((unsigned char) c < 0x20) {
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				out += escaped;
+			} else {
+				out += c;
+			}
+		}
+	}
+	return out + "\"";
+}
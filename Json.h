@@ -0,0 +1,34 @@
+/*
+ * Json.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef JSON_H_
+#define JSON_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+//just enough JSON for one object per line on the analysis and tool streams
+struct JsonValue {
+	enum type_t {
+		NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT
+	};
+	type_t type = NUL;
+	bool boolean = false;
+	double number = 0;
+	std::string text;
+	std::vector<JsonValue> items;
+	std::vector<std::pair<std::string, JsonValue>> members;
+
+	const JsonValue* get(const std::string &key) const; //nullptr if missing
+};
+
+bool json_parse(const std::string &text, JsonValue &out, std::string &error);
+
+std::string json_quote(const std::string &text); //escaped and quoted
+
+#endif /* JSON_H_ */
@@ -0,0 +1,346 @@
+/*
+ * LifeDeath.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "LifeDeath.h"
+#include "MappedFile.h"
+#include "Sgf.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#define LD_INFINITY 0x3FFFFFFFu //proof numbers saturate here
+
+static uint32_t saturate(uint64_t value) {
+	return (uint32_t) std::min<uint64_t>(value, LD_INFINITY);
+}
+
+std::vector<int> life_death_region(const Board &board, int target, int radius) {
+	//flood the target chain, then take every point near one of its stones
+	std::vector<int> region;
+	int size = board.get_boardsize();
+	Board::vertex_t colour = board.get_state((uint16_t) target);
+	std::vector<bool> chain(NUM_VERTICES, false);
+	std::vector<int> stack(1, target);
+	chain[target] = true;
+	while (!stack.empty()) {
+		int vertex = stack.back();
+		stack.pop_back();
+		for (int i = 0; i < 4; i++) {
+			int next = vertex + board.directions[i];
+			if (board.valid_vertex(next) && !chain[next]
+					&& board.get_state((uint16_t) next) == colour) {
+				chain[next] = true;
+				stack.push_back(next);
+			}
+		}
+	}
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			bool near = false;
+			for (int dx = -radius; dx <= radius && !near; dx++) {
+				for (int dy = -radius + std::abs(dx); dy <= radius - std::abs(dx) && !near;
+						dy++) {
+					int nx = x + dx, ny = y + dy;
+					near = nx >= 0 && ny >= 0 && nx < size && ny < size
+							&& chain[board.get_vertex(nx, ny)];
+				}
+			}
+			if (near) {
+				region.push_back(board.get_vertex(x, y));
+			}
+		}
+	}
+	return region;
+}
+
+LifeDeath::LifeDeath(uint8_t table_log2) {
+	table = std::vector<Entry>(1ull << table_log2, Entry { 0, 0, 0, 0 });
+	mask = (1ull << table_log2) - 1;
+	target = 0;
+	prover = true;
+	attacker = true;
+	max_depth = 0;
+	max_nodes = 0;
+	nodes = 0;
+	salt = 0;
+}
+
+uint64_t LifeDeath::key(uint64_t board_hash, bool side, int depth) const {
+	//the depth is part of the key because the horizon is, the history is
+	//left out as in the solver
+	return board_hash ^ salt ^ ((uint64_t) (depth + 1) * 0x9E3779B97F4A7C15ull)
+			^ (side ? 0 : 0xC2B2AE3D27D4EB4Full);
+}
+
+LifeDeath::Entry& LifeDeath::lookup(uint64_t key) {
+	return table[key & mask];
+}
+
+bool LifeDeath::terminal(Game &game, int depth, bool &mover_wins) {
+	bool mover = game.side();
+	const Board &board = game.get_board();
+	Board::vertex_t defender_colour = attacker ? Board::WHITE : Board::BLACK;
+	if (board.get_state((uint16_t) target) != defender_colour) {
+		mover_wins = (mover == attacker); //captured
+		return true;
+	}
+	//Benson runs after the defender's moves, which are what make life. a
+	//target left pass-alive by an attacker stone is found one ply later,
+	//through the defender's pass, and always at the horizon
+	static thread_local std::vector<bool> alive;
+	if (mover == attacker || depth >= max_depth) {
+		board.pass_alive(!attacker, alive);
+		if (alive[target]) {
+			mover_wins = (mover != attacker);
+			return true;
+		}
+	}
+	if (depth >= max_depth) {
+		mover_wins = (mover != prover); //the horizon goes against the prover
+		return true;
+	}
+	return false;
+}
+
+void LifeDeath::children(Game &game, int depth, std::vector<int> &moves,
+		std::vector<uint64_t> &keys) {
+	//the legality checks of Game::move and the hash of the board it would
+	//make, without copying the game for every child
+	const Board &board = game.get_board();
+	bool side = game.side();
+	moves.clear();
+	keys.clear();
+	for (int vertex : region) {
+		if (board.get_state((uint16_t) vertex) != Board::EMPTY
+				|| board.is_suicide(vertex, side) || game.repeated_board(vertex) >= 0) {
+			continue;
+		}
+		moves.push_back(vertex);
+		keys.push_back(key(board.hash_after(vertex, side), !side, depth + 1));
+	}
+	if (side != attacker) {
+		//the defender may tenuki, the attacker passing would just give up
+		moves.push_back(Board::PASS);
+		keys.push_back(key(board.get_hash(), !side, depth + 1));
+	}
+}
+
+void LifeDeath::mid(Game &game, int depth, uint32_t threshold_phi,
+		uint32_t threshold_delta) {
+	//phi is the proof number of the side to move, delta its disproof number.
+	//a child's delta is the parent's phi, the children's phis add up to its delta
+	nodes++;
+	uint64_t position = key(game.zobristHash(), game.side(), depth);
+	bool mover_wins;
+	if (terminal(game, depth, mover_wins)) {
+		lookup(position) = { position, mover_wins ? 0 : LD_INFINITY,
+				mover_wins ? LD_INFINITY : 0, Board::PASS };
+		return;
+	}
+	std::vector<int> moves;
+	std::vector<uint64_t> next;
+	children(game, depth, moves, next);
+	if (next.empty()) {
+		lookup(position) = { position, LD_INFINITY, 0, Board::PASS }; //nothing to try
+		return;
+	}
+
+	while (true) {
+		uint32_t phi = LD_INFINITY;
+		uint64_t delta = 0;
+		size_t best = 0;
+		uint32_t best_phi = 1, best_delta = LD_INFINITY + 1, second_delta =
+		LD_INFINITY;
+		for (size_t i = 0; i < next.size(); i++) {
+			uint64_t child_key = next[i];
+			const Entry &entry = lookup(child_key);
+			uint32_t child_phi = 1, child_delta = 1; //unexplored
+			if (entry.key == child_key) {
+				child_phi = entry.phi;
+				child_delta = entry.delta;
+			}
+			phi = std::min(phi, child_delta);
+			delta += child_phi;
+			if (child_delta < best_delta) {
+				second_delta = std::min(second_delta, best_delta);
+				best_delta = child_delta;
+				best_phi = child_phi;
+				best = i;
+			} else {
+				second_delta = std::min(second_delta, child_delta);
+			}
+		}
+		lookup(position) = { position, phi, saturate(delta), (int16_t) moves[best] };
+		if (phi >= threshold_phi || saturate(delta) >= threshold_delta
+				|| nodes >= max_nodes) {
+			return;
+		}
+		uint32_t child_phi = saturate(
+				(uint64_t) threshold_delta - saturate(delta) + best_phi);
+		uint32_t child_delta = std::min<uint64_t>(threshold_phi,
+				(uint64_t) second_delta + 1);
+		Game child(game);
+		child.move(moves[best]);
+		mid(child, depth + 1, child_phi, child_delta);
+	}
+}
+
+LifeDeathResult LifeDeath::solve(const Game &position, int target_,
+		const std::vector<int> &region_, const LifeDeathLimits &limits) {
+	Game root(position);
+	target = target_;
+	region = region_;
+	prover = root.side();
+	Board::vertex_t colour = root.get_board().get_state((uint16_t) target);
+	attacker = (colour == Board::WHITE);
+	max_depth = limits.depth ? limits.depth : 2 * (int) region.size();
+	max_nodes = limits.nodes;
+	nodes = 0;
+	salt += 0xD6E8FEB86659FD93ull;
+
+	LifeDeathResult result = { LifeDeathResult::UNKNOWN, Board::PASS, 0 };
+	if (colour != Board::BLACK && colour != Board::WHITE) {
+		return result; //no chain to fight over
+	}
+	mid(root, 0, LD_INFINITY, LD_INFINITY);
+	uint64_t root_key = key(root.zobristHash(), root.side(), 0);
+	const Entry &entry = lookup(root_key);
+	if (entry.key == root_key) {
+		if (entry.phi == 0) {
+			result.status = LifeDeathResult::PROVED;
+			result.move = entry.move;
+		} else if (entry.delta == 0) {
+			result.status = LifeDeathResult::DISPROVED;
+		}
+	}
+	result.nodes = nodes;
+	return result;
+}
+
+LifeDeath::~LifeDeath() {
+}
+
+//collects the problem marks while SgfReplay sets up the stones
+class ProblemReader: public SgfReplay {
+public:
+	ProblemReader(LifeDeath &solver_, const LifeDeathLimits &limits_) :
+			SgfReplay([this](Game &game) {
+				solve(game);
+			}), solver(solver_), limits(limits_) {
+	}
+
+	void game_begin() override {
+		SgfReplay::game_begin();
+		target.clear();
+		region.clear();
+		to_play = 0;
+	}
+
+	void property(std::string_view name, std::string_view value) override {
+		SgfReplay::property(name, value);
+		if (name == "TR" && target.empty()) {
+			target = std::string(value);
+		} else if (name == "SQ") {
+			region.push_back(std::string(value));
+		} else if (name == "PL" && !value.empty()) {
+			to_play = value[0];
+		}
+	}
+
+	int problems = 0;
+	int proved = 0;
+	int disproved = 0;
+	uint64_t nodes = 0;
+private:
+	LifeDeath &solver;
+	LifeDeathLimits limits;
+	std::string target;
+	std::vector<std::string> region;
+	char to_play;
+
+	void solve(Game &game) {
+		const Board &board = game.get_board();
+		problems++;
+		if (to_play == 'B' || to_play == 'W') {
+			game.set_to_move(to_play == 'B');
+		}
+		int vertex = (target.size() == 2) ?
+				board.sgf_vertex(target[0], target[1]) : NUM_VERTICES;
+		if (vertex == NUM_VERTICES || vertex == Board::PASS) {
+			printf("problem %d: no TR target\n", problems);
+			return;
+		}
+		std::vector<int> points;
+		for (const std::string &point : region) {
+			int square = (point.size() == 2) ?
+					board.sgf_vertex(point[0], point[1]) : NUM_VERTICES;
+			if (square != NUM_VERTICES && square != Board::PASS) {
+				points.push_back(square);
+			}
+		}
+		if (points.empty()) {
+			points = life_death_region(board, vertex);
+		}
+		LifeDeathResult result = solver.solve(game, vertex, points, limits);
+		nodes += result.nodes;
+		bool attacking = board.get_state((uint16_t) vertex)
+				!= (game.side() ? Board::BLACK : Board::WHITE);
+		const char *goal = attacking ? "kill" : "live";
+		if (result.status == LifeDeathResult::PROVED) {
+			proved++;
+			printf("problem %d: %c to %s at %s, %llu nodes\n", problems,
+					game.side() ? 'B' : 'W', goal,
+					result.move == Board::PASS ? "pass" : game.move_to_text(result.move).c_str(),
+					(unsigned long long) result.nodes);
+		} else if (result.status == LifeDeathResult::DISPROVED) {
+			disproved++;
+			printf("problem %d: %c cannot %s, %llu nodes\n", problems,
+					game.side() ? 'B' : 'W', goal, (unsigned long long) result.nodes);
+		} else {
+			printf("problem %d: unknown after %llu nodes\n", problems,
+					(unsigned long long) result.nodes);
+		}
+	}
+};
+
+int life_death_main(int argc, char *argv[]) {
+	LifeDeathLimits limits;
+	int first = 0;
+	if (argc > 0 && isdigit((unsigned char) argv[0][0])) {
+		limits.nodes = std::stoull(argv[0]);
+		first = 1;
+	}
+	if (first >= argc) {
+		printf("usage: GoAI tsumego [max nodes] <file.sgf>...\n");
+		return 1;
+	}
+	LifeDeath solver;
+	ProblemReader reader(solver, limits);
+	auto start = std::chrono::steady_clock::now();
+	for (int i = first; i < argc; i++) {
+		MappedFile file;
+		std::string error;
+		if (!file.open(argv[i])) {
+			fprintf(stderr, "%s: cannot open\n", argv[i]);
+			continue;
+		}
+		if (!sgf_parse(file.data(), file.data() + file.size(), reader, true, error)) {
+			fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+		}
+	}
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	int solved = reader.proved + reader.disproved;
+	printf("%d problems, %d proved, %d disproved, %d unknown\n", reader.problems,
+			reader.proved, reader.disproved, reader.problems - solved);
+	printf("%.2f s, %.1f solved/s, %.0f nodes/s\n", seconds,
+			solved / std::max(seconds, 1e-9),
+			reader.nodes / std::max(seconds, 1e-9));
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * LifeDeath.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef LIFEDEATH_H_
+#define LIFEDEATH_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <vector>
+
+#define LD_RADIUS 2 //default region: points this close to the target chain
+
+struct LifeDeathLimits {
+	uint64_t nodes = 100000; //node budget before giving up
+	int depth = 0; //plies read before the side to move is counted as failing, 0 for 2 * region
+};
+
+struct LifeDeathResult {
+	enum status_t {
+		PROVED, DISPROVED, UNKNOWN
+	};
+	status_t status; //can the side to move get its way: capture the target, or keep it
+	int move; //a winning first move when proved, Board::PASS for tenuki
+	uint64_t nodes;
+};
+
+//the points within radius of the chain at target, any state
+std::vector<int> life_death_region(const Board &board, int target,
+		int radius = LD_RADIUS);
+
+//depth-first proof-number search of a local fight. the attacker wins by
+//capturing the target chain, the defender by making it pass-alive (Benson)
+//or by the attacker running out of moves. only region points are played,
+//plus the defender's pass. running past the depth limit counts against the
+//side to move, so proofs are sound and only disproofs depend on the horizon
+class LifeDeath {
+public:
+	LifeDeath(uint8_t table_log2 = 20);
+
+	LifeDeathResult solve(const Game &position, int target,
+			const std::vector<int> &region, const LifeDeathLimits &limits);
+
+	virtual ~LifeDeath();
+private:
+	struct Entry {
+		uint64_t key;
+		uint32_t phi; //proof number for the side to move
+		uint32_t delta; //its disproof number
+		int16_t move; //best move found so far
+	};
+
+	std::vector<Entry> table;
+	uint64_t mask;
+	std::vector<int> region;
+	int target;
+	bool prover; //side to move at the root
+	bool attacker;
+	int max_depth;
+	uint64_t max_nodes;
+	uint64_t nodes;
+	uint64_t salt; //changes with every solve, so the table never needs clearing
+
+	void mid(Game &game, int depth, uint32_t threshold_phi, uint32_t threshold_delta);
+	bool terminal(Game &game, int depth, bool &mover_wins);
+	//the legal moves and their child keys. games are only made for the child
+	//searched next
+	void children(Game &game, int depth, std::vector<int> &moves,
+			std::vector<uint64_t> &keys);
+	uint64_t key(uint64_t board_hash, bool side, int depth) const;
+	Entry& lookup(uint64_t key);
+};
+
+//"GoAI tsumego [max nodes] <file.sgf>...": every game tree is a problem.
+//AB/AW set it up, PL says who moves, TR marks a stone of the target chain
+//and SQ the region (LD_RADIUS around the target without it)
+int life_death_main(int argc, char *argv[]);
+
+#endif /* LIFEDEATH_H_ */
@@ -0,0 +1,252 @@
+/*
+ * MCTS.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "MCTS.h"
+#include "AI.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#define MCTS_PASS_PRIOR 0.01 //share of the heuristic priors given to pass
+
+MCTS::MCTS(Evaluator &evaluator_, int threads_, double cpuct_) :
+		evaluator(evaluator_) {
+	threads = threads_;
+	cpuct = cpuct_;
+	widen_base = 2;
+	widen_exponent = 0.5;
+	bias = 0.5;
+	root = make_node(Board::PASS, 1, 0);
+	remaining = 0;
+	playouts = 0;
+	nodes = 1;
+}
+
+MCTS::Node MCTS::make_node(int16_t move, float prior, float heuristic) {
+	Node node;
+	node.move = move;
+	node.prior = prior;
+	node.heuristic = heuristic;
+	node.visits = 0;
+	node.virtual_loss = 0;
+	node.value_sum = 0;
+	node.expanded = false;
+	return node;
+}
+
+void MCTS::set_widening(double widen_base_, double widen_exponent_,
+		double bias_) {
+	widen_base = widen_base_;
+	widen_exponent = widen_exponent_;
+	bias = bias_;
+}
+
+int MCTS::search(const Game &root_game, int count) {
+	root = make_node(Board::PASS, 1, 0);
+	nodes = 1;
+	remaining = count;
+	Game start(root_game);
+	start.benson(true); //every simulation inherits the settled areas
+	start.benson(false);
+	std::vector<std::thread> helpers;
+	for (int i = 1; i < threads; i++) {
+		helpers.emplace_back(&MCTS::run, this, std::cref(start));
+	}
+	run(start);
+	for (std::thread &helper : helpers) {
+		helper.join();
+	}
+
+	const Node *best = nullptr;
+	for (const std::unique_ptr<Node> &child : root.children) {
+		if (!best || child->visits > best->visits) {
+			best = child.get();
+		}
+	}
+	return best ? best->move : Board::PASS;
+}
+
+void MCTS::run(const Game &root_game) {
+	while (remaining-- > 0) {
+		simulate(root_game);
+		playouts++;
+	}
+}
+
+void MCTS::simulate(const Game &root_game) {
+	Game game(root_game);
+	std::vector<Node*> path;
+	Node *node = &root;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		path.push_back(node);
+		node->virtual_loss++;
+		while (node->expanded && game.ongoing()) {
+			Node *child = select_child(*node, game);
+			if (!child) {
+				break; //nothing legal was left to unlock
+			}
+			node = child;
+			game.move(node->move);
+			path.push_back(node);
+			node->virtual_loss++;
+		}
+	}
+
+	//expansion and evaluation happen outside the lock, so evaluator calls
+	//from several threads can meet in the same batch. expanding only ranks the
+	//moves, legality is checked as they are unlocked
+	Evaluation evaluation;
+	if (game.ongoing()) {
+		evaluator.evaluate(game, evaluation);
+	} else {
+		//two passes ended the game, its result is exact
+		double score = game.final_score(game.get_komi());
+		evaluation.value = (score > 0) - (score < 0);
+	}
+	std::vector<Candidate> candidates;
+	if (!node->expanded && game.ongoing()) {
+		const Board &board = game.get_board();
+		int size = game.get_size();
+		bool side = game.side();
+		static thread_local std::vector<int> moves;
+		static thread_local std::vector<float> scores;
+		moves.clear();
+		for (int x = 0; x < size; x++) {
+			for (int y = 0; y < size; y++) {
+				int vertex = game.get_vertex(x, y);
+				if (board.get_state((uint16_t) vertex) == Board::EMPTY
+						&& !game.settled(vertex) && !board.is_eye(vertex, side)) {
+					moves.push_back(vertex);
+				}
+			}
+		}
+		heuristics(game, moves, scores);
+		double total = 0;
+		float highest = 0;
+		for (size_t i = 0; i < moves.size(); i++) {
+			std::pair<uint8_t, uint8_t> xy = board.get_xy(moves[i]);
+			float prior = evaluation.policy.empty() ?
+					scores[i] : evaluation.policy[xy.first * size + xy.second];
+			candidates.push_back( { (int16_t) moves[i], prior, scores[i] });
+			total += prior;
+			highest = std::max(highest, scores[i]);
+		}
+		//pass is always a candidate, so finished positions can be reached.
+		//its low prior unlocks it last
+		float pass_prior = !evaluation.policy.empty() ?
+				evaluation.policy[size * size] :
+				(total > 0 ? MCTS_PASS_PRIOR * total : 1);
+		candidates.push_back( { (int16_t) Board::PASS, pass_prior, 0 });
+		total += pass_prior;
+		for (Candidate &candidate : candidates) {
+			candidate.prior = (total > 0) ?
+					candidate.prior / total : 1.f / candidates.size();
+			candidate.heuristic = (highest > 0) ? candidate.heuristic / highest : 0;
+		}
+		std::stable_sort(candidates.begin(), candidates.end(),
+				[](const Candidate &a, const Candidate &b) {
+					return a.prior < b.prior;
+				});
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!node->expanded) {
+		node->locked = std::move(candidates); //another thread may have expanded it first
+		node->expanded = true;
+	}
+	for (Node *visited : path) {
+		visited->virtual_loss--;
+		visited->visits++;
+		visited->value_sum += evaluation.value;
+	}
+}
+
+void MCTS::unlock(Node &node, Game &game) {
+	size_t allowed = node.children.size() + node.locked.size();
+	if (widen_base > 0) {
+		allowed = std::min(allowed, (size_t) std::ceil(widen_base
+				* std::pow(node.visits + 1.0, widen_exponent)));
+	}
+	const Board &board = game.get_board();
+	bool side = game.side();
+	while (node.children.size() < allowed && !node.locked.empty()) {
+		Candidate next = node.locked.back();
+		node.locked.pop_back();
+		if (next.move != Board::PASS && (board.is_suicide(next.move, side)
+				|| game.repeated_board(next.move) >= 0)) {
+			continue; //illegal here, the next one takes its place
+		}
+		node.children.emplace_back(
+				new Node(make_node(next.move, next.prior, next.heuristic)));
+		nodes++;
+	}
+	if (node.locked.empty() && node.locked.capacity()) {
+		std::vector<Candidate>().swap(node.locked);
+	}
+}
+
+void MCTS::heuristics(Game &game, const std::vector<int> &moves,
+		std::vector<float> &out) {
+	//the positional weight of the point, more next to the last stone placed
+	//and more again for captures and escapes from atari
+	const Board &board = game.get_board();
+	int size = game.get_size();
+	const std::vector<uint16_t> &recent = board.get_pattern_changes();
+	static thread_local std::vector<int> ataris;
+	board.get_atari_moves(game.side(), ataris);
+	out.resize(moves.size());
+	for (size_t i = 0; i < moves.size(); i++) {
+		std::pair<uint8_t, uint8_t> xy = board.get_xy(moves[i]);
+		float score = vertex_influence(xy.first, xy.second, size);
+		if (std::find(recent.begin(), recent.end(), moves[i]) != recent.end()) {
+			score += 1;
+		}
+		if (std::find(ataris.begin(), ataris.end(), moves[i]) != ataris.end()) {
+			score += 2;
+		}
+		out[i] = score;
+	}
+}
+
+MCTS::Node* MCTS::select_child(Node &node, Game &game) {
+	unlock(node, game);
+	double sign = game.side() ? 1 : -1;
+	double parent_visits = node.visits + node.virtual_loss;
+	double sqrt_visits = std::sqrt(std::max(1.0, parent_visits));
+	double parent_q = node.visits ? sign * node.value_sum / node.visits : 0;
+	Node *best = nullptr;
+	double best_score = -1e30;
+	for (const std::unique_ptr<Node> &child : node.children) {
+		//pending visits count as losses for the side choosing
+		double visits = child->visits + child->virtual_loss;
+		double q = (visits > 0) ?
+				(sign * child->value_sum - child->virtual_loss) / visits : parent_q;
+		double u = cpuct * child->prior * sqrt_visits / (1 + visits);
+		double progressive = bias * child->heuristic / (1 + visits);
+		if (q + u + progressive > best_score) {
+			best_score = q + u + progressive;
+			best = child.get();
+		}
+	}
+	return best;
+}
+
+uint64_t MCTS::get_playouts() const {
+	return playouts;
+}
+
+uint64_t MCTS::get_nodes() const {
+	return nodes;
+}
+
+double MCTS::get_root_value() const {
+	return root.visits ? root.value_sum / root.visits : 0;
+}
+
+MCTS::~MCTS() {
+}
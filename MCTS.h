@@ -0,0 +1,84 @@
+/*
+ * MCTS.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef MCTS_H_
+#define MCTS_H_
+
+#include "Game.h"
+#include "Evaluator.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//PUCT tree search. leaves are scored by an Evaluator, whose policy (when it
+//has one) gives the priors. several threads share one tree, and virtual loss
+//keeps them on different leaves so their evaluations can be batched.
+//
+//children are unlocked a few at a time (progressive widening): a node with n
+//visits has ceil(widen_base * (n + 1)^widen_exponent) of them, best prior
+//first. without a policy the priors come from the move heuristics, which
+//also add bias * heuristic / (1 + visits) to the selection score.
+//
+//pass is a candidate everywhere, with the policy's prior or a small share
+//of the heuristic ones. a game ended by two passes is a terminal node,
+//valued by its final score instead of the evaluator
+class MCTS {
+public:
+	MCTS(Evaluator &evaluator, int threads = 1, double cpuct = 1.5);
+
+	int search(const Game &root, int playouts); //returns the most visited move
+	//a widen_base of 0 unlocks every child at the first visit
+	void set_widening(double widen_base, double widen_exponent, double bias);
+
+	uint64_t get_playouts() const;
+	uint64_t get_nodes() const; //in the tree of the last search
+	double get_root_value() const; //black's point of view
+
+	virtual ~MCTS();
+private:
+	struct Candidate { //a child not unlocked yet
+		int16_t move;
+		float prior;
+		float heuristic; //0 to 1
+	};
+	struct Node {
+		int16_t move;
+		float prior;
+		float heuristic;
+		uint32_t visits;
+		int32_t virtual_loss;
+		double value_sum; //black's point of view
+		bool expanded;
+		//children never move once unlocked, other threads may hold pointers to them
+		std::vector<std::unique_ptr<Node>> children;
+		std::vector<Candidate> locked; //lowest prior first, the back is next
+	};
+
+	Evaluator &evaluator;
+	int threads;
+	double cpuct;
+	double widen_base;
+	double widen_exponent;
+	double bias;
+	std::mutex mutex;
+	Node root;
+	std::atomic<int> remaining;
+	std::atomic<uint64_t> playouts;
+	std::atomic<uint64_t> nodes;
+
+	void run(const Game &root_game);
+	void simulate(const Game &root_game);
+	Node* select_child(Node &node, Game &game);
+	void unlock(Node &node, Game &game); //as many children as its visits allow
+	static void heuristics(Game &game, const std::vector<int> &moves,
+			std::vector<float> &out);
+	static Node make_node(int16_t move, float prior, float heuristic);
+};
+
+#endif /* MCTS_H_ */
@@ -0,0 +1,181 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+	view = nullptr;
+	length = 0;
+	writable = false;
+#ifdef _WIN32
+	file = INVALID_HANDLE_VALUE;
+	mapping = nullptr;
+#else
+	descriptor = -1;
+#endif
+}
+
+bool MappedFile::open(const std::string &path) {
+	close();
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		close();
+		return false;
+	}
+	length = (size_t) file_size.QuadPart;
+	if (length == 0) {
+		return true; //nothing to map, data() stays null
+	}
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		close();
+		return false;
+	}
+	view = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(descriptor, &info) != 0) {
+		close();
+		return false;
+	}
+	length = (size_t) info.st_size;
+	if (length == 0) {
+		return true;
+	}
+	void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (mapped == MAP_FAILED) {
+		close();
+		return false;
+	}
+	madvise(mapped, length, MADV_SEQUENTIAL);
+	view = (const char*) mapped;
+#endif
+	if (!view) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::open_shared(const std::string &path, size_t size) {
+	close();
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		close();
+		return false;
+	}
+	length = std::max((size_t) file_size.QuadPart, size);
+	//the mapping grows the file to length
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+			(DWORD) ((uint64_t) length >> 32), (DWORD) length, nullptr);
+	if (!mapping) {
+		close();
+		return false;
+	}
+	view = (const char*) MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+#else
+	descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (descriptor < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(descriptor, &info) != 0) {
+		close();
+		return false;
+	}
+	length = std::max((size_t) info.st_size, size);
+	if (length == 0 || ((size_t) info.st_size < length
+			&& ftruncate(descriptor, length) != 0)) {
+		close();
+		return false;
+	}
+	void *mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+			descriptor, 0);
+	if (mapped == MAP_FAILED) {
+		close();
+		return false;
+	}
+	view = (const char*) mapped;
+#endif
+	if (!view) {
+		close();
+		return false;
+	}
+	writable = true;
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+	if (view) {
+		UnmapViewOfFile(view);
+	}
+	if (mapping) {
+		CloseHandle(mapping);
+	}
+	if (file != INVALID_HANDLE_VALUE) {
+		CloseHandle(file);
+	}
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (view) {
+		munmap((void*) view, length);
+	}
+	if (descriptor >= 0) {
+		::close(descriptor);
+	}
+	descriptor = -1;
+#endif
+	view = nullptr;
+	length = 0;
+	writable = false;
+}
+
+const char* MappedFile::data() const {
+	return view;
+}
+
+char* MappedFile::writable_data() const {
+	return writable ? (char*) view : nullptr;
+}
+
+size_t MappedFile::size() const {
+	return length;
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
@@ -0,0 +1,45 @@
+/*
+ * MappedFile.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+
+//view of a whole file, mapped rather than read so parsers can point
+//straight into it. read-only unless opened with open_shared
+class MappedFile {
+public:
+	MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const std::string &path);
+	//read-write and visible to every process mapping the same file, which is
+	//created or grown to at least size bytes
+	bool open_shared(const std::string &path, size_t size);
+	void close();
+
+	const char* data() const;
+	char* writable_data() const; //null unless opened with open_shared
+	size_t size() const;
+
+	virtual ~MappedFile();
+private:
+	const char *view;
+	size_t length;
+	bool writable;
+#ifdef _WIN32
+	void *file;
+	void *mapping;
+#else
+	int descriptor;
+#endif
+};
+
+#endif /* MAPPEDFILE_H_ */
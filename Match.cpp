@@ -0,0 +1,256 @@
+/*
+ * Match.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Match.h"
+#include "SelfPlay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#define SPRT_MIN_VARIANCE 0.05 //of one game's score, which is at most 0.25
+
+bool parse_engine(const std::string &spec, EngineConfig &out,
+		std::string &error) {
+	if (spec == "-") {
+		return true;
+	}
+	std::istringstream in(spec);
+	std::string item;
+	while (std::getline(in, item, ',')) {
+		size_t equals = item.find('=');
+		if (equals == std::string::npos) {
+			error = "expected key=value: " + item;
+			return false;
+		}
+		std::string key = item.substr(0, equals);
+		std::string value = item.substr(equals + 1);
+		try {
+			if (key == "name") {
+				out.name = value;
+			} else if (key == "depth") {
+				out.limits.depth = std::stoi(value);
+			} else if (key == "seconds") {
+				out.limits.seconds = std::stod(value);
+			} else if (key == "nodes") {
+				out.limits.nodes = std::stoull(value);
+			} else if (key == "influence") {
+				out.limits.weights.influence = std::stod(value);
+			} else if (key == "prisoners") {
+				out.limits.weights.prisoners = std::stod(value);
+			} else {
+				error = "unknown setting: " + key;
+				return false;
+			}
+		} catch (const std::exception&) {
+			error = "bad value for " + key + ": " + value;
+			return false;
+		}
+	}
+	return true;
+}
+
+static double expected_score(double elo) {
+	return 1 / (1 + std::pow(10, -elo / 400));
+}
+
+static double score_elo(double score) {
+	return -400 * std::log10(1 / score - 1);
+}
+
+//mean and variance of one game's score, with pseudo games added to every
+//outcome
+static void score_moments(int wins, int draws, int losses, double pseudo,
+		double &mean, double &variance) {
+	double w = wins + pseudo, d = draws + pseudo, l = losses + pseudo;
+	double n = w + d + l;
+	mean = (w + d / 2) / n;
+	variance = (w * (1 - mean) * (1 - mean) + d * (0.5 - mean) * (0.5 - mean)
+			+ l * mean * mean) / n;
+}
+
+double sprt_llr(int wins, int draws, int losses, double elo0, double elo1) {
+	int games = wins + draws + losses;
+	if (!games) {
+		return 0;
+	}
+	double mean, variance;
+	score_moments(wins, draws, losses, 0, mean, variance);
+	//a one-sided start has no variance at all, the floor keeps it from
+	//deciding the test by itself
+	variance = std::max(variance, SPRT_MIN_VARIANCE);
+	double s0 = expected_score(elo0), s1 = expected_score(elo1);
+	return games * (s1 - s0) * (2 * mean - s0 - s1) / (2 * variance);
+}
+
+void elo_estimate(int wins, int draws, int losses, double &elo,
+		double &error) {
+	int games = wins + draws + losses;
+	if (!games) {
+		elo = 0;
+		error = 0;
+		return;
+	}
+	double mean, variance, padded_mean;
+	score_moments(wins, draws, losses, 0, mean, variance);
+	//the error bar adds half a game to every outcome, so a one-sided
+	//result still gets a finite width
+	score_moments(wins, draws, losses, 0.5, padded_mean, variance);
+	double margin = 1.96 * std::sqrt(variance / games);
+	double low = std::max(mean - margin, 1e-6);
+	double high = std::min(mean + margin, 1 - 1e-6);
+	elo = score_elo(std::max(1e-6, std::min(mean, 1 - 1e-6)));
+	error = (score_elo(high) - score_elo(low)) / 2;
+}
+
+//score of one game, black's point of view. the opening plies are random,
+//then each engine searches for its own colour
+static double play_game(const Game &empty, const EngineConfig engines[2],
+		bool first_black, const MatchConfig &config,
+		std::mt19937 &randGen, double seconds[2]) {
+	Game game(empty);
+	int max_moves = 3 * config.board_size * config.board_size;
+	for (int moves = 0; game.ongoing() && moves < max_moves; moves++) {
+		int move;
+		if (moves < config.opening_plies) {
+			move = random_move(game, randGen);
+		} else {
+			int engine = (game.side() == first_black) ? 0 : 1;
+			SearchResult result = search(game, engines[engine].limits);
+			seconds[engine] += result.seconds;
+			move = result.move;
+		}
+		if (!game.move(move)) {
+			game.move(Board::PASS); //search only returns legal moves, this is a safety net
+		}
+	}
+	return game.final_score(config.komi);
+}
+
+MatchResult run_match(const EngineConfig engines[2], const MatchConfig &config) {
+	Game empty(config.board_size);
+	empty.set_komi(config.komi);
+	double lower = std::log(config.beta / (1 - config.alpha));
+	double upper = std::log((1 - config.beta) / config.alpha);
+
+	MatchResult result = { 0, 0, 0, 0, 0, 0, 0, 0, 0, { 0, 0 } };
+	std::mutex mutex; //result
+	std::atomic<int> next(0);
+	std::atomic<bool> stop(false);
+	auto start = std::chrono::steady_clock::now();
+	std::clock_t cpu_start = std::clock();
+	int report_every = std::max(2, config.games / 20);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < config.threads; t++) {
+		workers.emplace_back([&]() {
+			std::mt19937 randGen;
+			for (int i = next++; i < config.games && !stop; i = next++) {
+				randGen.seed(config.seed + i / 2); //both games of a pair share the opening
+				bool first_black = (i % 2 == 0);
+				double seconds[2] = { 0, 0 };
+				double score = play_game(empty, engines, first_black,
+						config, randGen, seconds);
+
+				std::lock_guard<std::mutex> lock(mutex);
+				if (score == 0) {
+					result.draws++;
+				} else if ((score > 0) == first_black) {
+					result.wins++;
+				} else {
+					result.losses++;
+				}
+				result.search_seconds[0] += seconds[0];
+				result.search_seconds[1] += seconds[1];
+				int played = result.wins + result.draws + result.losses;
+				if (config.sprt && !result.decision) {
+					result.llr = sprt_llr(result.wins, result.draws, result.losses,
+							config.elo0, config.elo1);
+					if (result.llr >= upper || result.llr <= lower) {
+						result.decision = (result.llr >= upper) ? 1 : -1;
+						stop = true; //games already started still count
+					}
+				}
+				if (played % report_every == 0) {
+					double elo, error;
+					elo_estimate(result.wins, result.draws, result.losses, elo, error);
+					fprintf(stderr, "%d games, +%d =%d -%d, elo %.1f +/- %.1f, "
+							"llr %.2f\n", played, result.wins, result.draws,
+							result.losses, elo, error, result.llr);
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	elo_estimate(result.wins, result.draws, result.losses, result.elo,
+			result.elo_error);
+	result.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	result.cpu_seconds = (double) (std::clock() - cpu_start) / CLOCKS_PER_SEC;
+	return result;
+}
+
+int match_main(int argc, char *argv[]) {
+	if (argc < 2) {
+		printf("usage: GoAI match <engine a> <engine b> [games] [boardsize] "
+				"[threads] [elo0] [elo1] [opening plies]\n"
+				"an engine is \"-\" or key=value pairs joined by commas, keys: "
+				"name depth seconds nodes influence prisoners\n");
+		return 1;
+	}
+	EngineConfig engines[2];
+	engines[0].name = "a";
+	engines[1].name = "b";
+	for (int e = 0; e < 2; e++) {
+		std::string error;
+		if (!parse_engine(argv[e], engines[e], error)) {
+			printf("%s\n", error.c_str());
+			return 1;
+		}
+	}
+	MatchConfig config;
+	config.games = (argc > 2) ? std::stoi(argv[2]) : 1000;
+	int size = (argc > 3) ? std::stoi(argv[3]) : 9;
+	config.threads = (argc > 4) ? std::stoi(argv[4]) :
+						std::max(1u, std::thread::hardware_concurrency());
+	config.elo0 = (argc > 5) ? std::stod(argv[5]) : 0;
+	config.elo1 = (argc > 6) ? std::stod(argv[6]) : 20;
+	config.opening_plies = (argc > 7) ? std::stoi(argv[7]) : 4;
+	if (size < 2 || size > MAX_BOARDSIZE) {
+		printf("unsupported board size %d\n", size);
+		return 1;
+	}
+	config.board_size = size;
+
+	MatchResult result = run_match(engines, config);
+	int games = result.wins + result.draws + result.losses;
+	if (!games) {
+		printf("no games played\n");
+		return 1;
+	}
+	printf("%s vs %s: %d games, +%d =%d -%d\n", engines[0].name.c_str(),
+			engines[1].name.c_str(), games, result.wins, result.draws,
+			result.losses);
+	printf("elo %.1f +/- %.1f (95%%)\n", result.elo, result.elo_error);
+	printf("sprt elo0 %.1f elo1 %.1f: llr %.2f in [%.2f, %.2f], %s\n", config.elo0,
+			config.elo1, result.llr, std::log(config.beta / (1 - config.alpha)),
+			std::log((1 - config.beta) / config.alpha),
+			result.decision > 0 ? "H1 accepted" :
+			result.decision < 0 ? "H0 accepted" : "no decision");
+	printf("%.1f s, cpu %.3f s/game, search %s %.3f s/game, %s %.3f s/game\n",
+			result.seconds, result.cpu_seconds / games, engines[0].name.c_str(),
+			result.search_seconds[0] / games, engines[1].name.c_str(),
+			result.search_seconds[1] / games);
+	return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Match.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef MATCH_H_
+#define MATCH_H_
+
+#include "AI.h"
+#include <cstdint>
+#include <string>
+
+//one side of a match. limits.weights holds its Game::score() weights, so
+//both engines run the same batched leaf evaluation
+struct EngineConfig {
+	std::string name;
+	SearchLimits limits;
+};
+
+//"depth=3,seconds=0.5,nodes=0,influence=0.2,prisoners=2,name=wide", any
+//subset, "-" for the defaults
+bool parse_engine(const std::string &spec, EngineConfig &out,
+		std::string &error);
+
+struct MatchConfig {
+	uint8_t board_size = 9;
+	double komi = 7;
+	int games = 1000; //at most, an SPRT decision stops the match earlier
+	int threads = 1;
+	int opening_plies = 4; //random moves shared by both games of a pair
+	uint32_t seed = 1;
+	bool sprt = true;
+	double elo0 = 0; //H0: the first engine is this much stronger
+	double elo1 = 20; //H1
+	double alpha = 0.05; //false positive rate
+	double beta = 0.05; //false negative rate
+};
+
+struct MatchResult {
+	int wins; //first engine's point of view
+	int draws;
+	int losses;
+	double elo;
+	double elo_error; //95% interval half width
+	double llr; //log likelihood ratio of H1 against H0
+	int decision; //1 for H1, -1 for H0, 0 for none
+	double seconds; //wall clock
+	double cpu_seconds; //the whole process
+	double search_seconds[2]; //per engine, summed over games
+};
+
+//normal approximation of the trinomial log likelihood ratio, as used by
+//fishtest, from the raw counts with a floor on the variance. elo0 and elo1
+//are logistic Elo
+double sprt_llr(int wins, int draws, int losses, double elo0, double elo1);
+//elo of the raw score, clamped. the 95% error bar pads every outcome with
+//half a game
+void elo_estimate(int wins, int draws, int losses, double &elo,
+		double &error);
+
+//plays pairs of games from the same random opening with colours swapped, on
+//config.threads workers, until config.games or an SPRT decision
+MatchResult run_match(const EngineConfig engines[2], const MatchConfig &config);
+
+//"GoAI match <engine a> <engine b> [games] [boardsize] [threads] [elo0]
+//[elo1] [opening plies]"
+int match_main(int argc, char *argv[]);
+
+#endif /* MATCH_H_ */
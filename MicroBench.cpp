@@ -0,0 +1,393 @@
+/*
+ * MicroBench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "MicroBench.h"
+#include "AI.h"
+#include "Bench.h"
+#include "Json.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#ifdef GOAI_COUNT_ALLOCATIONS
+//every heap allocation in the program goes through here. a thread local
+//count costs next to nothing and needs no synchronisation
+static thread_local uint64_t allocations = 0;
+
+static void* counted_malloc(std::size_t size, std::size_t alignment) noexcept {
+	allocations++;
+	size = size ? size : 1;
+	if (alignment <= alignof(std::max_align_t)) {
+		return std::malloc(size);
+	}
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void *memory = nullptr;
+	return posix_memalign(&memory, alignment, size) ? nullptr : memory;
+#endif
+}
+
+static void counted_free(void *memory, std::size_t alignment) noexcept {
+#ifdef _WIN32
+	if (alignment > alignof(std::max_align_t)) {
+		_aligned_free(memory);
+		return;
+	}
+#endif
+	(void) alignment;
+	std::free(memory);
+}
+
+static void* counted_new(std::size_t size, std::size_t alignment) {
+	void *memory = counted_malloc(size, alignment);
+	if (!memory) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new(std::size_t size) {
+	return counted_new(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+	return counted_new(size, 0);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return counted_malloc(size, 0);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return counted_malloc(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return counted_new(size, (std::size_t) alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return counted_new(size, (std::size_t) alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	return counted_malloc(size, (std::size_t) alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	return counted_malloc(size, (std::size_t) alignment);
+}
+
+void operator delete(void *memory) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete[](void *memory) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete(void *memory, const std::nothrow_t&) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete[](void *memory, const std::nothrow_t&) noexcept {
+	counted_free(memory, 0);
+}
+
+void operator delete(void *memory, std::align_val_t alignment) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+void operator delete[](void *memory, std::align_val_t alignment) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+void operator delete(void *memory, std::size_t,
+		std::align_val_t alignment) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+void operator delete[](void *memory, std::size_t,
+		std::align_val_t alignment) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+void operator delete(void *memory, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+void operator delete[](void *memory, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	counted_free(memory, (std::size_t) alignment);
+}
+
+uint64_t allocation_count() {
+	return allocations;
+}
+
+bool allocations_counted() {
+	return true;
+}
+#else
+uint64_t allocation_count() {
+	return 0;
+}
+
+bool allocations_counted() {
+	return false;
+}
+#endif
+
+static volatile uint64_t sink; //keeps results of const calls alive
+
+//runs prepare untimed, then run(i) for i in [0, batch) timed, until the
+//budget is spent and at least once
+template<typename Prepare, typename Run>
+static MicroResult measure(const std::string &name, int board_size,
+		int milliseconds, size_t batch, Prepare prepare, Run run) {
+	MicroResult result = { name, board_size, 0, 0, 0, 0 };
+	double elapsed = 0;
+	uint64_t allocated = 0;
+	while (batch && (elapsed * 1000 < milliseconds || result.ops == 0)) {
+		prepare();
+		uint64_t before = allocation_count();
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < batch; i++) {
+			run(i);
+		}
+		elapsed += std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		allocated += allocation_count() - before;
+		result.ops += batch;
+	}
+	if (result.ops) {
+		result.ns_per_op = elapsed * 1e9 / result.ops;
+		result.allocations_per_op =
+				allocations_counted() ? (double) allocated / result.ops : -1;
+	}
+	return result;
+}
+
+std::vector<MicroResult> micro_bench(int milliseconds) {
+	std::vector<MicroResult> results;
+	auto nothing = [] {
+	};
+	for (uint8_t size : { 9, 13, 19 }) {
+		std::vector<Game> positions = bench_positions(size, 64, size * size / 3,
+				1);
+		std::mt19937 randGen(size);
+
+		//one legal point per position to play, a second list of points that
+		//join two of the mover's chains, and ataris to capture
+		struct Placement {
+			int position;
+			uint16_t vertex;
+			Board::vertex_t colour;
+		};
+		std::vector<Placement> placements, merges;
+		std::vector<Board> captures_ready;
+		std::vector<uint16_t> captured;
+		std::vector<std::pair<const Board*, uint16_t>> empties;
+		for (size_t p = 0; p < positions.size(); p++) {
+			Game &game = positions[p];
+			const Board &board = game.get_board();
+			bool side = game.side();
+			Board::vertex_t colour = side ? Board::BLACK : Board::WHITE;
+			int offset = randGen() % (size * size);
+			bool placed = false, merged = false;
+			for (int k = 0; k < size * size; k++) {
+				int index = (k + offset) % (size * size);
+				uint16_t vertex = board.get_vertex(index / size, index % size);
+				if (board.get_state(vertex) != Board::EMPTY) {
+					continue;
+				}
+				empties.push_back( { &board, vertex });
+				Game test(game);
+				if (!test.move(vertex)) {
+					continue;
+				}
+				if (!placed) {
+					placements.push_back( { (int) p, vertex, colour });
+					placed = true;
+				}
+				uint8_t first = 255;
+				for (int d = 0; d < 4 && !merged; d++) {
+					int neighbor = vertex + board.directions[d];
+					if (board.valid_vertex(neighbor)
+							&& board.get_state((uint16_t) neighbor) == colour) {
+						uint8_t chain = board.get_chain_index(neighbor);
+						if (first != 255 && chain != first) {
+							merges.push_back( { (int) p, vertex, colour });
+							merged = true;
+						}
+						first = chain;
+					}
+				}
+			}
+			for (uint8_t chain : board.get_low_liberty_chains(!side, 1)) {
+				uint16_t liberty[2];
+				board.get_chain_liberty_vertices(chain, liberty);
+				Game test(game);
+				if (!test.move(liberty[0])) {
+					continue;
+				}
+				for (int d = 0; d < 4; d++) {
+					int neighbor = liberty[0] + board.directions[d];
+					if (board.valid_vertex(neighbor)
+							&& board.get_chain_index(neighbor) == chain) {
+						Board ready(board);
+						ready.set_state(liberty[0], colour);
+						captures_ready.push_back(ready);
+						captured.push_back(neighbor);
+						break;
+					}
+				}
+				break;
+			}
+		}
+
+		std::vector<Board> boards;
+		std::vector<Game> games;
+		auto fresh_boards = [&](const std::vector<Placement> &items) {
+			boards.clear();
+			for (const Placement &item : items) {
+				boards.push_back(positions[item.position].get_board());
+			}
+		};
+		results.push_back(
+				measure("Board::set_state", size, milliseconds, placements.size(),
+						[&] {
+							fresh_boards(placements);
+						}, [&](size_t i) {
+							boards[i].set_state(placements[i].vertex, placements[i].colour);
+						}));
+		results.push_back(
+				measure("Board::set_state/merge", size, milliseconds, merges.size(),
+						[&] {
+							fresh_boards(merges);
+						}, [&](size_t i) {
+							boards[i].set_state(merges[i].vertex, merges[i].colour);
+						}));
+		results.push_back(
+				measure("Board::capture_chain", size, milliseconds, captured.size(),
+						[&] {
+							boards = captures_ready;
+						}, [&](size_t i) {
+							boards[i].capture_chain(captured[i]);
+						}));
+		results.push_back(
+				measure("Board::is_suicide", size, milliseconds, empties.size(),
+						nothing, [&](size_t i) {
+							sink += empties[i].first->is_suicide(empties[i].second, true);
+						}));
+		results.push_back(
+				measure("Board::is_eye", size, milliseconds, empties.size(),
+						nothing, [&](size_t i) {
+							sink += empties[i].first->is_eye(empties[i].second, true);
+						}));
+		results.push_back(
+				measure("Game::move", size, milliseconds, placements.size(), [&] {
+					games.clear();
+					for (const Placement &item : placements) {
+						games.push_back(positions[item.position]);
+					}
+				}, [&](size_t i) {
+					sink += games[i].move((int16_t) placements[i].vertex);
+				}));
+		results.push_back(
+				measure("Game::zobristHash", size, milliseconds, positions.size(),
+						nothing, [&](size_t i) {
+							sink += positions[i].zobristHash();
+						}));
+		results.push_back(
+				measure("Game::score", size, milliseconds, positions.size(),
+						nothing, [&](size_t i) {
+							sink += (uint64_t) positions[i].score();
+						}));
+		results.push_back(
+				measure("Game::Game(const Game&)", size, milliseconds,
+						positions.size(), nothing, [&](size_t i) {
+							Game copy(positions[i]);
+							sink += copy.get_play_num();
+						}));
+
+		for (int depth = 1; depth <= (size == 9 ? 3 : 2); depth++) {
+			uint64_t nodes = 0;
+			MicroResult result = measure("bestMove/" + std::to_string(depth), size,
+					milliseconds, 1, nothing, [&](size_t) {
+						//a different position each time, the leaf cache stays warm
+						srand(1);
+						SearchLimits limits;
+						limits.depth = depth;
+						nodes += search(positions[nodes % positions.size()], limits).nodes;
+					});
+			result.nodes_per_second = nodes / (result.ns_per_op * result.ops * 1e-9);
+			results.push_back(result);
+		}
+	}
+	return results;
+}
+
+int micro_bench_main(int argc, char *argv[]) {
+	int milliseconds = (argc > 0) ? std::stoi(argv[0]) : 200;
+	std::string format = (argc > 1) ? argv[1] : "text";
+	if (format != "text" && format != "json" && format != "csv") {
+		printf("unknown format: %s\n", format.c_str());
+		return 1;
+	}
+	std::vector<MicroResult> results = micro_bench(milliseconds);
+	if (format == "text" && !allocations_counted()) {
+		printf("built without GOAI_COUNT_ALLOCATIONS, allocs/op is not measured\n");
+	}
+	if (format == "csv") {
+		printf("name,board_size,ops,ns_per_op,allocations_per_op,nodes_per_second\n");
+	}
+	for (const MicroResult &result : results) {
+		if (!result.ops) {
+			continue; //nothing in the position set to measure
+		}
+		if (format == "json") {
+			printf("{\"name\": %s, \"board_size\": %d, \"ops\": %llu, "
+					"\"ns_per_op\": %.2f, \"allocations_per_op\": %.3f, "
+					"\"nodes_per_second\": %.0f}\n", json_quote(result.name).c_str(),
+					result.board_size, (unsigned long long) result.ops,
+					result.ns_per_op, result.allocations_per_op,
+					result.nodes_per_second);
+		} else if (format == "csv") {
+			printf("%s,%d,%llu,%.2f,%.3f,%.0f\n", result.name.c_str(),
+					result.board_size, (unsigned long long) result.ops,
+					result.ns_per_op, result.allocations_per_op,
+					result.nodes_per_second);
+		} else {
+			printf("%-26s %2dx%-2d %12.1f ns/op", result.name.c_str(),
+					result.board_size, result.board_size, result.ns_per_op);
+			if (result.allocations_per_op >= 0) {
+				printf(" %9.2f allocs/op", result.allocations_per_op);
+			}
+			if (result.nodes_per_second > 0) {
+				printf(" %12.0f nodes/s", result.nodes_per_second);
+			}
+			printf("\n");
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * MicroBench.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef MICROBENCH_H_
+#define MICROBENCH_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MicroResult {
+	std::string name;
+	int board_size;
+	uint64_t ops;
+	double ns_per_op;
+	double allocations_per_op; //-1 unless built with GOAI_COUNT_ALLOCATIONS
+	double nodes_per_second; //searches only, 0 otherwise
+};
+
+//times the Board and Game operations everything else is built on, each over
+//the same seeded positions on 9x9, 13x13 and 19x19
+std::vector<MicroResult> micro_bench(int milliseconds_per_op);
+
+//heap allocations made by this thread so far. only a build with
+//-DGOAI_COUNT_ALLOCATIONS replaces the global operator new and delete in
+//MicroBench.cpp to count them, every other build returns 0
+uint64_t allocation_count();
+bool allocations_counted();
+
+//"GoAI bench core [milliseconds per op] [text|json|csv]". json is one object
+//per line, csv has a header row
+int micro_bench_main(int argc, char *argv[]);
+
+#endif /* MICROBENCH_H_ */
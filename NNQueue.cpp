@@ -0,0 +1,118 @@
+/*
+ * NNQueue.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "NNQueue.h"
+
+NNQueue::NNQueue(const Network &network_, int batch_size_, int wait_us) :
+		network(network_) {
+	batch_size = batch_size_;
+	wait = std::chrono::microseconds(wait_us);
+	stopping = false;
+	batches = 0;
+	positions = 0;
+	rejected = 0;
+	worker = std::thread(&NNQueue::run, this);
+}
+
+std::future<NNQueue::Result> NNQueue::submit(const Game &game) {
+	Request request;
+	std::future<Result> out = request.promise.get_future();
+	if (game.get_board().get_boardsize() != network.get_boardsize()) {
+		//input_planes would write past planes sized for the network
+		rejected++;
+		request.promise.set_value( { { }, 0.f });
+		return out;
+	}
+	int vertices = network.get_boardsize() * network.get_boardsize();
+	request.planes.resize(NETWORK_INPUT_PLANES * vertices);
+	Network::input_planes(game, request.planes.data());
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(std::move(request));
+	}
+	arrived.notify_one();
+	return out;
+}
+
+void NNQueue::run() {
+	int vertices = network.get_boardsize() * network.get_boardsize();
+	std::vector<Request> batch;
+	std::vector<float> inputs, policy, values;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			arrived.wait(lock, [this] {
+				return stopping || !pending.empty();
+			});
+			if (stopping && pending.empty()) {
+				return;
+			}
+			//give the other search threads a moment to fill the batch
+			auto deadline = std::chrono::steady_clock::now() + wait;
+			arrived.wait_until(lock, deadline, [this] {
+				return stopping || (int) pending.size() >= batch_size;
+			});
+			while (!pending.empty() && (int) batch.size() < batch_size) {
+				batch.push_back(std::move(pending.front()));
+				pending.pop_front();
+			}
+		}
+
+		int count = batch.size();
+		inputs.resize((size_t) count * NETWORK_INPUT_PLANES * vertices);
+		for (int i = 0; i < count; i++) {
+			std::copy(batch[i].planes.begin(), batch[i].planes.end(),
+					inputs.begin() + (size_t) i * NETWORK_INPUT_PLANES * vertices);
+		}
+		policy.resize((size_t) count * (vertices + 1));
+		values.resize(count);
+		network.forward(inputs.data(), count, policy.data(), values.data());
+		for (int i = 0; i < count; i++) {
+			Result result;
+			result.policy.assign(policy.begin() + (size_t) i * (vertices + 1),
+					policy.begin() + (size_t) (i + 1) * (vertices + 1));
+			result.value = values[i];
+			batch[i].promise.set_value(std::move(result));
+		}
+		batches++;
+		positions += count;
+		batch.clear();
+	}
+}
+
+int NNQueue::get_batch_size() const {
+	return batch_size;
+}
+
+uint8_t NNQueue::get_boardsize() const {
+	return network.get_boardsize();
+}
+
+uint64_t NNQueue::get_fingerprint() const {
+	return network.get_fingerprint();
+}
+
+uint64_t NNQueue::get_batches() const {
+	return batches;
+}
+
+uint64_t NNQueue::get_positions() const {
+	return positions;
+}
+
+uint64_t NNQueue::get_rejected() const {
+	return rejected;
+}
+
+NNQueue::~NNQueue() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	arrived.notify_one();
+	worker.join();
+}
@@ -0,0 +1,67 @@
+/*
+ * NNQueue.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef NNQUEUE_H_
+#define NNQUEUE_H_
+
+#include "Network.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//collects positions from many search threads and runs them through the
+//network as one batch, either when the batch is full or when the oldest
+//request has waited long enough
+class NNQueue {
+public:
+	struct Result {
+		std::vector<float> policy; //[vertices + 1], pass last
+		float value; //side to move's point of view
+	};
+
+	NNQueue(const Network &network, int batch_size, int wait_us = 500);
+
+	//a game of another size than the network is not run: its result is ready
+	//at once, with no policy and a value of 0
+	std::future<Result> submit(const Game &game);
+
+	int get_batch_size() const;
+	uint8_t get_boardsize() const;
+	uint64_t get_fingerprint() const; //of the network
+	uint64_t get_batches() const;
+	uint64_t get_positions() const;
+	uint64_t get_rejected() const; //games of the wrong size
+
+	virtual ~NNQueue();
+private:
+	struct Request {
+		std::vector<float> planes;
+		std::promise<Result> promise;
+	};
+
+	const Network &network;
+	int batch_size;
+	std::chrono::microseconds wait;
+
+	std::mutex mutex;
+	std::condition_variable arrived;
+	std::deque<Request> pending;
+	bool stopping;
+	std::atomic<uint64_t> batches;
+	std::atomic<uint64_t> positions;
+	std::atomic<uint64_t> rejected;
+	std::thread worker;
+
+	void run();
+};
+
+#endif /* NNQUEUE_H_ */
@@ -0,0 +1,414 @@
+/*
+ * Network.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Network.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NETWORK_X86
+#endif
+
+#define GEMM_ROWS 4 //rows of C per register block
+#define GEMM_COLUMNS 16 //columns of C per register block, two vectors of 8
+
+static const char NETWORK_MAGIC[4] = { 'G', 'O', 'N', 'N' };
+
+typedef float floats8 __attribute__((vector_size(32)));
+
+#define LOAD8(p) ({ floats8 loaded; memcpy(&loaded, (p), sizeof(floats8)); loaded; })
+#define STORE8(p, value) ({ floats8 stored = (value); memcpy((p), &stored, sizeof(floats8)); })
+
+//each GEMM_ROWS x GEMM_COLUMNS block of C stays in registers for the whole
+//k loop: per step, two loads from the packed B panel feed eight multiply-adds.
+//the panel is copied out of B once and reused by every row block
+__attribute__((always_inline)) static inline void gemm_kernel(int m, int n,
+		int k, const float *a, const float *b, float *c) {
+	static thread_local std::vector<float> panel;
+	panel.resize((size_t) k * GEMM_COLUMNS);
+	int vector_columns = n / GEMM_COLUMNS * GEMM_COLUMNS;
+	for (int j = 0; j < vector_columns; j += GEMM_COLUMNS) {
+		for (int p = 0; p < k; p++) {
+			memcpy(&panel[(size_t) p * GEMM_COLUMNS], b + (size_t) p * n + j,
+					GEMM_COLUMNS * sizeof(float));
+		}
+		for (int i = 0; i < m; i += GEMM_ROWS) {
+			int rows = std::min(GEMM_ROWS, m - i);
+			floats8 sum[GEMM_ROWS][2] = { };
+			const float *packed = panel.data();
+			for (int p = 0; p < k; p++, packed += GEMM_COLUMNS) {
+				floats8 low = LOAD8(packed);
+				floats8 high = LOAD8(packed + 8);
+				for (int r = 0; r < GEMM_ROWS; r++) {
+					float scalar = (r < rows) ? a[(size_t) (i + r) * k + p] : 0.f;
+					sum[r][0] += scalar * low;
+					sum[r][1] += scalar * high;
+				}
+			}
+			for (int r = 0; r < rows; r++) {
+				STORE8(c + (size_t) (i + r) * n + j, sum[r][0]);
+				STORE8(c + (size_t) (i + r) * n + j + 8, sum[r][1]);
+			}
+		}
+	}
+	for (int i = 0; i < m; i++) {
+		for (int j = vector_columns; j < n; j++) {
+			float sum = 0;
+			for (int p = 0; p < k; p++) {
+				sum += a[(size_t) i * k + p] * b[(size_t) p * n + j];
+			}
+			c[(size_t) i * n + j] = sum;
+		}
+	}
+}
+
+#ifdef NETWORK_X86
+__attribute__((target("avx2,fma")))
+static void gemm_avx2(int m, int n, int k, const float *a, const float *b,
+		float *c) {
+	gemm_kernel(m, n, k, a, b, c);
+}
+#endif
+
+static void gemm_generic(int m, int n, int k, const float *a, const float *b,
+		float *c) {
+	gemm_kernel(m, n, k, a, b, c);
+}
+
+void gemm(int m, int n, int k, const float *a, const float *b, float *c) {
+#ifdef NETWORK_X86
+	static const bool avx2 = __builtin_cpu_supports("avx2")
+			&& __builtin_cpu_supports("fma");
+	if (avx2) {
+		gemm_avx2(m, n, k, a, b, c);
+		return;
+	}
+#endif
+	gemm_generic(m, n, k, a, b, c);
+}
+
+Network::Network() {
+	board_size = 0;
+	channels = 0;
+	blocks = 0;
+	value_hidden = 0;
+	fingerprint = 0;
+}
+
+uint8_t Network::get_boardsize() const {
+	return board_size;
+}
+
+int Network::get_channels() const {
+	return channels;
+}
+
+uint64_t Network::get_fingerprint() const {
+	return fingerprint;
+}
+
+void Network::update_fingerprint() {
+	//fnv-1a over the header fields and the bits of every weight
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](uint32_t word) {
+		for (int i = 0; i < 4; i++) {
+			hash = (hash ^ ((word >> (8 * i)) & 0xFF)) * 0x100000001B3ull;
+		}
+	};
+	mix(board_size);
+	mix(channels);
+	mix(blocks);
+	mix(value_hidden);
+	for (std::vector<float> *p : parameters()) {
+		for (float weight : *p) {
+			uint32_t bits;
+			memcpy(&bits, &weight, sizeof(bits));
+			mix(bits);
+		}
+	}
+	fingerprint = hash;
+}
+
+int Network::get_blocks() const {
+	return blocks;
+}
+
+std::vector<std::vector<float>*> Network::parameters() {
+	//file order of the weights after the header
+	std::vector<std::vector<float>*> out = { &input_weights, &input_biases };
+	for (int i = 0; i < 2 * blocks; i++) {
+		out.push_back(&residual_weights[i]);
+		out.push_back(&residual_biases[i]);
+	}
+	for (std::vector<float> *p : { &policy_conv_weights, &policy_conv_biases,
+			&policy_fc_weights, &policy_fc_biases, &value_conv_weights,
+			&value_conv_biases, &value_fc1_weights, &value_fc1_biases,
+			&value_fc2_weights, &value_fc2_biases }) {
+		out.push_back(p);
+	}
+	return out;
+}
+
+void Network::resize() {
+	int vertices = board_size * board_size;
+	input_weights.assign(channels * NETWORK_INPUT_PLANES * 9, 0);
+	input_biases.assign(channels, 0);
+	residual_weights.assign(2 * blocks, std::vector<float>(channels * channels * 9, 0));
+	residual_biases.assign(2 * blocks, std::vector<float>(channels, 0));
+	policy_conv_weights.assign(2 * channels, 0);
+	policy_conv_biases.assign(2, 0);
+	policy_fc_weights.assign(2 * vertices * (vertices + 1), 0);
+	policy_fc_biases.assign(vertices + 1, 0);
+	value_conv_weights.assign(channels, 0);
+	value_conv_biases.assign(1, 0);
+	value_fc1_weights.assign(vertices * value_hidden, 0);
+	value_fc1_biases.assign(value_hidden, 0);
+	value_fc2_weights.assign(value_hidden, 0);
+	value_fc2_biases.assign(1, 0);
+}
+
+/*
+ * file layout, little endian: "GONN", uint32 version, uint32 board size,
+ * uint32 input planes, uint32 channels, uint32 blocks, uint32 value hidden,
+ * then every parameter array as float32 in the order of parameters()
+ */
+bool Network::load(const std::string &path) {
+	FILE *file = fopen(path.c_str(), "rb");
+	if (!file) {
+		return false;
+	}
+	char magic[4];
+	uint32_t header[6];
+	bool ok = fread(magic, 1, 4, file) == 4
+			&& memcmp(magic, NETWORK_MAGIC, 4) == 0
+			&& fread(header, sizeof(uint32_t), 6, file) == 6
+			&& header[0] == NETWORK_VERSION
+			&& header[1] >= 2 && header[1] <= MAX_BOARDSIZE
+			&& header[2] == NETWORK_INPUT_PLANES
+			&& header[3] >= 1 && header[3] <= NETWORK_MAX_CHANNELS
+			&& header[4] <= NETWORK_MAX_BLOCKS
+			&& header[5] >= 1 && header[5] <= NETWORK_MAX_VALUE_HIDDEN;
+	if (ok) {
+		board_size = header[1];
+		channels = header[3];
+		blocks = header[4];
+		value_hidden = header[5];
+		resize();
+		for (std::vector<float> *p : parameters()) {
+			ok = ok && fread(p->data(), sizeof(float), p->size(), file) == p->size();
+		}
+		if (ok) {
+			update_fingerprint();
+		}
+	}
+	fclose(file);
+	return ok;
+}
+
+bool Network::save(const std::string &path) const {
+	FILE *file = fopen(path.c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+	uint32_t header[6] = { NETWORK_VERSION, board_size, NETWORK_INPUT_PLANES,
+			(uint32_t) channels, (uint32_t) blocks, (uint32_t) value_hidden };
+	bool ok = fwrite(NETWORK_MAGIC, 1, 4, file) == 4
+			&& fwrite(header, sizeof(uint32_t), 6, file) == 6;
+	for (std::vector<float> *p : const_cast<Network*>(this)->parameters()) {
+		ok = ok && fwrite(p->data(), sizeof(float), p->size(), file) == p->size();
+	}
+	return fclose(file) == 0 && ok;
+}
+
+void Network::init_random(uint8_t board_size_, int channels_, int blocks_,
+		uint32_t seed) {
+	board_size = board_size_;
+	channels = channels_;
+	blocks = blocks_;
+	value_hidden = 64;
+	resize();
+	int vertices = board_size * board_size;
+	std::mt19937 randGen(seed);
+	auto fill = [&](std::vector<float> &weights, int fan_in) {
+		std::normal_distribution<float> dist(0.f, std::sqrt(2.f / fan_in)); //he initialization
+		for (float &w : weights) {
+			w = dist(randGen);
+		}
+	};
+	fill(input_weights, NETWORK_INPUT_PLANES * 9);
+	for (std::vector<float> &weights : residual_weights) {
+		fill(weights, channels * 9);
+	}
+	fill(policy_conv_weights, channels);
+	fill(policy_fc_weights, 2 * vertices);
+	fill(value_conv_weights, channels);
+	fill(value_fc1_weights, vertices);
+	fill(value_fc2_weights, value_hidden);
+	update_fingerprint();
+}
+
+void Network::input_planes(const Game &game, float *out) {
+	const Board &board = game.get_board();
+	int size = board.get_boardsize();
+	int vertices = size * size;
+	Board::vertex_t own =
+			(game.get_play_num() % 2 == 0) ? Board::BLACK : Board::WHITE;
+	std::fill(out, out + NETWORK_INPUT_PLANES * vertices, 0.f);
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			int i = x * size + y;
+			Board::vertex_t state = board.get_state((uint8_t) x, (uint8_t) y);
+			out[7 * vertices + i] = 1;
+			if (state == Board::EMPTY) {
+				out[2 * vertices + i] = 1;
+				continue;
+			}
+			int mine = (state == own) ? 0 : 1;
+			out[mine * vertices + i] = 1;
+			int liberties = board.get_chain_liberties(board.get_vertex(x, y));
+			if (liberties == 1) {
+				out[(3 + mine) * vertices + i] = 1;
+			} else if (liberties == 2) {
+				out[(5 + mine) * vertices + i] = 1;
+			}
+		}
+	}
+}
+
+void Network::conv3x3(const float *in, int in_channels, float *out,
+		int out_channels, const float *weights, const float *biases, int batch,
+		std::vector<float> &columns) const {
+	int vertices = board_size * board_size;
+	int width = batch * vertices;
+	columns.resize((size_t) in_channels * 9 * width);
+	//im2col: row (channel, offset) holds that channel shifted by the offset, 0 off the board
+	for (int c = 0; c < in_channels; c++) {
+		for (int k = 0; k < 9; k++) {
+			int dx = k / 3 - 1;
+			int dy = k % 3 - 1;
+			float *row = &columns[(size_t) (c * 9 + k) * width];
+			for (int b = 0; b < batch; b++) {
+				const float *plane = in + (size_t) c * width + b * vertices;
+				float *dst = row + b * vertices;
+				for (int x = 0; x < board_size; x++) {
+					for (int y = 0; y < board_size; y++) {
+						int sx = x + dx;
+						int sy = y + dy;
+						bool inside = sx >= 0 && sx < board_size && sy >= 0
+								&& sy < board_size;
+						dst[x * board_size + y] = inside ? plane[sx * board_size + sy] : 0.f;
+					}
+				}
+			}
+		}
+	}
+	gemm(out_channels, width, in_channels * 9, weights, columns.data(), out);
+	for (int c = 0; c < out_channels; c++) {
+		float *row = out + (size_t) c * width;
+		for (int i = 0; i < width; i++) {
+			row[i] += biases[c];
+		}
+	}
+}
+
+void Network::forward(const float *inputs, int batch, float *policy,
+		float *values) const {
+	int vertices = board_size * board_size;
+	int width = batch * vertices;
+	static thread_local std::vector<float> planes, x, y, skip, columns, head,
+			flat, hidden;
+
+	//[batch][plane][vertex] to [plane][batch][vertex]
+	planes.resize((size_t) NETWORK_INPUT_PLANES * width);
+	for (int b = 0; b < batch; b++) {
+		for (int p = 0; p < NETWORK_INPUT_PLANES; p++) {
+			memcpy(&planes[(size_t) p * width + b * vertices],
+					inputs + ((size_t) b * NETWORK_INPUT_PLANES + p) * vertices,
+					vertices * sizeof(float));
+		}
+	}
+
+	x.resize((size_t) channels * width);
+	y.resize((size_t) channels * width);
+	conv3x3(planes.data(), NETWORK_INPUT_PLANES, x.data(), channels,
+			input_weights.data(), input_biases.data(), batch, columns);
+	for (float &v : x) {
+		v = std::max(v, 0.f);
+	}
+	for (int block = 0; block < blocks; block++) {
+		conv3x3(x.data(), channels, y.data(), channels,
+				residual_weights[2 * block].data(), residual_biases[2 * block].data(),
+				batch, columns);
+		for (float &v : y) {
+			v = std::max(v, 0.f);
+		}
+		skip = x;
+		conv3x3(y.data(), channels, x.data(), channels,
+				residual_weights[2 * block + 1].data(),
+				residual_biases[2 * block + 1].data(), batch, columns);
+		for (size_t i = 0; i < x.size(); i++) {
+			x[i] = std::max(x[i] + skip[i], 0.f);
+		}
+	}
+
+	//policy: 1x1 convolution to 2 planes, then a fully connected layer per position
+	head.resize(2 * width);
+	gemm(2, width, channels, policy_conv_weights.data(), x.data(), head.data());
+	flat.resize((size_t) batch * 2 * vertices);
+	for (int c = 0; c < 2; c++) {
+		for (int b = 0; b < batch; b++) {
+			for (int i = 0; i < vertices; i++) {
+				flat[(size_t) b * 2 * vertices + c * vertices + i] = std::max(
+						head[(size_t) c * width + b * vertices + i] + policy_conv_biases[c],
+						0.f);
+			}
+		}
+	}
+	gemm(batch, vertices + 1, 2 * vertices, flat.data(),
+			policy_fc_weights.data(), policy);
+	for (int b = 0; b < batch; b++) {
+		float *logits = policy + (size_t) b * (vertices + 1);
+		float highest = -1e30f;
+		for (int i = 0; i <= vertices; i++) {
+			logits[i] += policy_fc_biases[i];
+			highest = std::max(highest, logits[i]);
+		}
+		float sum = 0;
+		for (int i = 0; i <= vertices; i++) {
+			logits[i] = std::exp(logits[i] - highest);
+			sum += logits[i];
+		}
+		for (int i = 0; i <= vertices; i++) {
+			logits[i] /= sum;
+		}
+	}
+
+	//value: 1x1 convolution to 1 plane, hidden layer, tanh output
+	head.resize(width);
+	gemm(1, width, channels, value_conv_weights.data(), x.data(), head.data());
+	for (float &v : head) {
+		v = std::max(v + value_conv_biases[0], 0.f);
+	}
+	hidden.resize((size_t) batch * value_hidden);
+	gemm(batch, value_hidden, vertices, head.data(), value_fc1_weights.data(),
+			hidden.data());
+	for (int b = 0; b < batch; b++) {
+		float sum = value_fc2_biases[0];
+		for (int h = 0; h < value_hidden; h++) {
+			float activation = std::max(
+					hidden[(size_t) b * value_hidden + h] + value_fc1_biases[h], 0.f);
+			sum += activation * value_fc2_weights[h];
+		}
+		values[b] = std::tanh(sum);
+	}
+}
+
+Network::~Network() {
+}
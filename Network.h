@@ -0,0 +1,83 @@
+/*
+ * Network.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef NETWORK_H_
+#define NETWORK_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define NETWORK_INPUT_PLANES 8
+#define NETWORK_VERSION 1
+//limits on a loaded header, checked before any buffer is sized from it
+#define NETWORK_MAX_CHANNELS 256
+#define NETWORK_MAX_BLOCKS 40
+#define NETWORK_MAX_VALUE_HIDDEN 1024
+
+//small residual policy/value network, run on the cpu.
+//activations are stored channel-major over the whole batch ([channel][position][vertex])
+//so every convolution is one im2col and one GEMM for the batch
+class Network {
+public:
+	Network();
+
+	bool load(const std::string &path);
+	bool save(const std::string &path) const;
+	void init_random(uint8_t board_size, int channels, int blocks, uint32_t seed);
+
+	uint8_t get_boardsize() const;
+	int get_channels() const;
+	int get_blocks() const;
+	//hash of the shape and every weight, so results of different weights
+	//files never share a transposition table entry
+	uint64_t get_fingerprint() const;
+
+	//own stones, opponent stones, empty, own/opponent chains in atari,
+	//own/opponent chains with two liberties, ones. [plane][x * size + y]
+	static void input_planes(const Game &game, float *out);
+
+	//inputs are [batch][plane][vertex], policy is [batch][vertices + 1] with pass last,
+	//values are from the side to move's point of view in [-1, 1]
+	void forward(const float *inputs, int batch, float *policy, float *values) const;
+
+	virtual ~Network();
+private:
+	uint8_t board_size;
+	int channels;
+	int blocks;
+	int value_hidden;
+	uint64_t fingerprint;
+
+	std::vector<float> input_weights; //[channels][planes * 9]
+	std::vector<float> input_biases;
+	std::vector<std::vector<float>> residual_weights; //two convolutions per block
+	std::vector<std::vector<float>> residual_biases;
+	std::vector<float> policy_conv_weights; //[2][channels]
+	std::vector<float> policy_conv_biases;
+	std::vector<float> policy_fc_weights; //[2 * vertices][vertices + 1]
+	std::vector<float> policy_fc_biases;
+	std::vector<float> value_conv_weights; //[1][channels]
+	std::vector<float> value_conv_biases;
+	std::vector<float> value_fc1_weights; //[vertices][value_hidden]
+	std::vector<float> value_fc1_biases;
+	std::vector<float> value_fc2_weights; //[value_hidden][1]
+	std::vector<float> value_fc2_biases;
+
+	std::vector<std::vector<float>*> parameters();
+	void resize();
+	void update_fingerprint();
+	void conv3x3(const float *in, int in_channels, float *out, int out_channels,
+			const float *weights, const float *biases, int batch,
+			std::vector<float> &columns) const;
+};
+
+//C[m x n] = A[m x k] * B[k x n], all row major
+void gemm(int m, int n, int k, const float *a, const float *b, float *c);
+
+#endif /* NETWORK_H_ */
@@ -0,0 +1,336 @@
+/*
+ * Pattern.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Pattern.h"
+#include "MappedFile.h"
+#include "Sgf.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+uint32_t pattern_for_side(uint32_t pattern, bool side) {
+	if (side) {
+		return pattern;
+	}
+	//BLACK = 01 and WHITE = 10 trade places, EMPTY and INVAL stay
+	uint32_t differ = (pattern ^ (pattern >> 1)) & 0x5555;
+	return pattern ^ (differ | (differ << 1));
+}
+
+uint32_t pattern_symmetry(uint32_t pattern, int symmetry) {
+	//where each of the 8 neighbors goes, row by row from the north west
+	static const std::array<std::array<int, 8>, NUM_SYMMETRIES> moved = [] {
+		std::array<std::array<int, 8>, NUM_SYMMETRIES> out;
+		auto index = [](int row, int column) {
+			int k = (row + 1) * 3 + column + 1;
+			return k > 4 ? k - 1 : k; //the center has no slot
+		};
+		for (int s = 0; s < NUM_SYMMETRIES; s++) {
+			for (int row = -1; row <= 1; row++) {
+				for (int column = -1; column <= 1; column++) {
+					if (row == 0 && column == 0) {
+						continue;
+					}
+					int r = (s & 1) ? -row : row;
+					int c = (s & 2) ? -column : column;
+					if (s & 4) {
+						std::swap(r, c);
+					}
+					out[s][index(row, column)] = index(r, c);
+				}
+			}
+		}
+		return out;
+	}();
+	static const int atari_slot[4] = { 1, 3, 4, 6 }; //n, w, e, s
+	uint32_t out = 0;
+	for (int k = 0; k < 8; k++) {
+		out |= ((pattern >> (2 * k)) & 3) << (2 * moved[symmetry][k]);
+	}
+	for (int k = 0; k < 4; k++) {
+		if (pattern & (1u << (16 + k))) {
+			int slot = moved[symmetry][atari_slot[k]];
+			int bit = std::find(atari_slot, atari_slot + 4, slot) - atari_slot;
+			out |= 1u << (16 + bit);
+		}
+	}
+	return out;
+}
+
+uint32_t canonical_pattern(uint32_t pattern) {
+	uint32_t smallest = pattern;
+	for (int s = 1; s < NUM_SYMMETRIES; s++) {
+		smallest = std::min(smallest, pattern_symmetry(pattern, s));
+	}
+	return smallest;
+}
+
+PatternTable::PatternTable() {
+	default_weight = 1;
+	weights = std::vector<float>(PATTERN_CODES, default_weight);
+}
+
+bool PatternTable::load(const std::string &path) {
+	MappedFile file;
+	if (!file.open(path) || file.size() < sizeof(PatternHeader)) {
+		return false;
+	}
+	PatternHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	if (memcmp(header.magic, "GOPT", 4) != 0 || header.version != PATTERN_VERSION
+			|| file.size()
+					!= sizeof(header) + header.count * sizeof(PatternEntry)) {
+		return false;
+	}
+	std::vector<PatternEntry> loaded(header.count);
+	memcpy(loaded.data(), file.data() + sizeof(header),
+			header.count * sizeof(PatternEntry));
+	default_weight = header.default_weight;
+	weights.assign(PATTERN_CODES, default_weight);
+	entries.clear();
+	for (const PatternEntry &entry : loaded) {
+		if (entry.pattern >= PATTERN_CODES || !(entry.weight >= 0)) {
+			return false;
+		}
+		set_weight(entry.pattern, entry.weight);
+	}
+	return true;
+}
+
+bool PatternTable::save(const std::string &path) const {
+	std::vector<PatternEntry> sorted;
+	for (const auto &entry : entries) {
+		sorted.push_back( { entry.first, entry.second });
+	}
+	PatternHeader header;
+	memcpy(header.magic, "GOPT", 4);
+	header.version = PATTERN_VERSION;
+	header.count = sorted.size();
+	header.default_weight = default_weight;
+	std::ofstream out(path, std::ios::binary);
+	out.write((const char*) &header, sizeof(header));
+	out.write((const char*) sorted.data(), sorted.size() * sizeof(PatternEntry));
+	return (bool) out;
+}
+
+float PatternTable::weight(uint32_t pattern, bool side) const {
+	return weights[pattern_for_side(pattern, side)];
+}
+
+void PatternTable::set_weight(uint32_t pattern, float weight) {
+	uint32_t canonical = canonical_pattern(pattern);
+	for (int s = 0; s < NUM_SYMMETRIES; s++) {
+		weights[pattern_symmetry(canonical, s)] = weight;
+	}
+	entries[canonical] = weight;
+}
+
+size_t PatternTable::size() const {
+	return entries.size();
+}
+
+PatternTable::~PatternTable() {
+}
+
+PatternLearner::PatternLearner() {
+	seen = std::vector<uint32_t>(PATTERN_CODES, 0);
+	played = std::vector<uint32_t>(PATTERN_CODES, 0);
+	moves = 0;
+}
+
+void PatternLearner::add_position(const Game &game, int move, bool side) {
+	const Board &board = game.get_board();
+	if (move == Board::PASS || !board.valid_vertex(move)) {
+		return;
+	}
+	//the points a playout would have drawn from, legality aside
+	int size = board.get_boardsize();
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			int vertex = board.get_vertex(x, y);
+			if (board.get_state((uint16_t) vertex) == Board::EMPTY
+					&& !board.is_eye(vertex, side)) {
+				seen[pattern_for_side(board.get_pattern(vertex), side)]++;
+			}
+		}
+	}
+	played[pattern_for_side(board.get_pattern(move), side)]++;
+	moves++;
+}
+
+bool PatternLearner::add_file(const std::string &path, std::string &error) {
+	MappedFile file;
+	if (!file.open(path)) {
+		error = "cannot open " + path;
+		return false;
+	}
+	SgfReplay replay(nullptr);
+	replay.set_move_callback([this](const Game &game, int move, bool side) {
+		add_position(game, move, side);
+	});
+	return sgf_parse(file.data(), file.data() + file.size(), replay, true, error);
+}
+
+void PatternLearner::fill(PatternTable &table, uint32_t min_seen) const {
+	//symmetric images share a weight, so their counts are pooled first
+	std::vector<std::pair<uint64_t, uint64_t>> pooled(PATTERN_CODES, { 0, 0 });
+	uint64_t total_seen = 0, total_played = 0;
+	for (uint32_t pattern = 0; pattern < PATTERN_CODES; pattern++) {
+		if (seen[pattern]) {
+			uint32_t canonical = canonical_pattern(pattern);
+			pooled[canonical].first += seen[pattern];
+			pooled[canonical].second += played[pattern];
+			total_seen += seen[pattern];
+			total_played += played[pattern];
+		}
+	}
+	if (!total_seen) {
+		return;
+	}
+	double rate = (double) total_played / total_seen;
+	for (uint32_t pattern = 0; pattern < PATTERN_CODES; pattern++) {
+		if (pooled[pattern].first && pooled[pattern].first >= min_seen) {
+			table.set_weight(pattern,
+					(pooled[pattern].second + 1) / (pooled[pattern].first * rate + 1));
+		}
+	}
+}
+
+uint64_t PatternLearner::get_moves() const {
+	return moves;
+}
+
+PatternLearner::~PatternLearner() {
+}
+
+PatternSampler::PatternSampler() {
+	table = nullptr;
+	size = 0;
+	stride = 0;
+	totals[0] = 0;
+	totals[1] = 0;
+}
+
+void PatternSampler::reset(const Game &game, const PatternTable &table_) {
+	table = &table_;
+	size = game.get_board().get_boardsize();
+	stride = size + 2;
+	for (int side = 0; side < 2; side++) {
+		weights[side].assign(stride * stride, 0.f);
+		rows[side].assign(size, 0.0);
+		totals[side] = 0;
+	}
+	excluded.clear();
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			weigh(game, game.get_vertex(x, y));
+		}
+	}
+}
+
+void PatternSampler::update(const Game &game) {
+	for (uint16_t vertex : game.get_board().get_pattern_changes()) {
+		weigh(game, vertex);
+	}
+}
+
+int PatternSampler::sample(bool side, std::mt19937 &randGen) const {
+	int s = side ? 0 : 1;
+	if (totals[s] <= 0) {
+		return Board::PASS;
+	}
+	//a row by its sum, then a point in it. rounding in the running sums can
+	//leave the draw just past the end, the last point with weight takes it
+	double draw = std::uniform_real_distribution<double>(0, totals[s])(randGen);
+	int last = Board::PASS;
+	for (int x = 0; x < size; x++) {
+		if (draw >= rows[s][x]) {
+			draw -= rows[s][x];
+			if (rows[s][x] > 0) {
+				last = x;
+			}
+			continue;
+		}
+		last = x;
+		break;
+	}
+	if (last == Board::PASS) {
+		return Board::PASS;
+	}
+	const float *row = &weights[s][(last + 1) * stride + 1];
+	int chosen = -1;
+	for (int y = 0; y < size; y++) {
+		if (row[y] > 0) {
+			chosen = y;
+			if (draw < row[y]) {
+				break;
+			}
+			draw -= row[y];
+		}
+	}
+	return (chosen < 0) ? Board::PASS : (last + 1) * stride + 1 + chosen;
+}
+
+void PatternSampler::exclude(int vertex, bool side) {
+	int s = side ? 0 : 1;
+	excluded.push_back( { vertex, s, weights[s][vertex] });
+	set(s, vertex, 0.f);
+}
+
+void PatternSampler::restore() {
+	for (const Excluded &item : excluded) {
+		set(item.side, item.vertex, item.weight);
+	}
+	excluded.clear();
+}
+
+void PatternSampler::weigh(const Game &game, int vertex) {
+	const Board &board = game.get_board();
+	bool open = board.get_state((uint16_t) vertex) == Board::EMPTY
+			&& !game.settled(vertex);
+	uint32_t pattern = board.get_pattern(vertex);
+	for (int s = 0; s < 2; s++) {
+		bool side = (s == 0);
+		set(s, vertex, (open && !board.is_eye(vertex, side)) ?
+				table->weight(pattern, side) : 0.f);
+	}
+}
+
+void PatternSampler::set(int side, int vertex, float weight) {
+	float &current = weights[side][vertex];
+	double change = (double) weight - current;
+	current = weight;
+	rows[side][vertex / stride - 1] += change;
+	totals[side] += change;
+}
+
+PatternSampler::~PatternSampler() {
+}
+
+int pattern_main(int argc, char *argv[]) {
+	if (argc < 3) {
+		printf("usage: GoAI patterns <out.pat> <min seen> <file.sgf>...\n");
+		return 1;
+	}
+	PatternLearner learner;
+	for (int i = 2; i < argc; i++) {
+		std::string error;
+		if (!learner.add_file(argv[i], error)) {
+			fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+		}
+	}
+	PatternTable table;
+	learner.fill(table, std::stoi(argv[1]));
+	if (!table.save(argv[0])) {
+		printf("cannot write %s\n", argv[0]);
+		return 1;
+	}
+	printf("%llu moves, %zu patterns written to %s\n",
+			(unsigned long long) learner.get_moves(), table.size(), argv[0]);
+	return 0;
+}
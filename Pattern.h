@@ -0,0 +1,115 @@
+/*
+ * Pattern.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef PATTERN_H_
+#define PATTERN_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#define PATTERN_CODES (1 << 20) //see Board::get_pattern
+#define PATTERN_VERSION 1
+
+//file layout: the header, then count entries sorted by pattern
+struct PatternHeader {
+	char magic[4]; //"GOPT"
+	uint32_t version;
+	uint32_t count;
+	float default_weight; //patterns without an entry
+};
+
+struct PatternEntry {
+	uint32_t pattern; //canonical, black to move
+	float weight;
+};
+
+uint32_t pattern_for_side(uint32_t pattern, bool side); //colours swapped when white is to move
+uint32_t pattern_symmetry(uint32_t pattern, int symmetry); //one of the 8 rotations and reflections
+uint32_t canonical_pattern(uint32_t pattern); //smallest of the 8
+
+//weight of playing on an empty point, by its 3x3 pattern seen from the side
+//to move. the file only holds canonical patterns, the table expands them to
+//every code so a lookup is a single load
+class PatternTable {
+public:
+	PatternTable(); //every pattern weighs 1
+
+	bool load(const std::string &path);
+	bool save(const std::string &path) const;
+
+	float weight(uint32_t pattern, bool side) const;
+	void set_weight(uint32_t pattern, float weight); //and its symmetric images, black to move
+	size_t size() const; //patterns with their own weight
+
+	virtual ~PatternTable();
+private:
+	std::vector<float> weights; //[PATTERN_CODES], black to move
+	std::map<uint32_t, float> entries; //canonical pattern, weight
+	float default_weight;
+};
+
+//counts how often each pattern was played against how often it was there to
+//be played, over the moves of SGF archives
+class PatternLearner {
+public:
+	PatternLearner();
+
+	void add_position(const Game &game, int move, bool side);
+	bool add_file(const std::string &path, std::string &error);
+	//weight = (played + 1) / (seen * rate + 1), rate being the average over all
+	//patterns, so rare patterns stay near 1 and an average one is 1
+	void fill(PatternTable &table, uint32_t min_seen) const;
+
+	uint64_t get_moves() const;
+
+	virtual ~PatternLearner();
+private:
+	std::vector<uint32_t> seen; //[PATTERN_CODES], mover's point of view
+	std::vector<uint32_t> played;
+	uint64_t moves;
+};
+
+//draws empty points with probability proportional to their weight. weights
+//are kept per side along with row sums, and after a move only the points in
+//Board::get_pattern_changes() are weighed again
+class PatternSampler {
+public:
+	PatternSampler();
+
+	void reset(const Game &game, const PatternTable &table); //weighs every point
+	void update(const Game &game); //after a stone is played
+	int sample(bool side, std::mt19937 &randGen) const; //Board::PASS when nothing has weight
+	void exclude(int vertex, bool side); //illegal this turn, until restore()
+	void restore();
+
+	virtual ~PatternSampler();
+private:
+	const PatternTable *table;
+	int size;
+	int stride;
+	std::vector<float> weights[2]; //black to move, white to move
+	std::vector<double> rows[2];
+	double totals[2];
+	struct Excluded {
+		int vertex;
+		int side;
+		float weight;
+	};
+	std::vector<Excluded> excluded;
+
+	void weigh(const Game &game, int vertex);
+	void set(int side, int vertex, float weight);
+};
+
+//"GoAI patterns <out.pat> <min seen> <file.sgf>...": learns pattern weights
+int pattern_main(int argc, char *argv[]);
+
+#endif /* PATTERN_H_ */
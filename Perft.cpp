@@ -0,0 +1,201 @@
+/*
+ * Perft.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Perft.h"
+#include "MappedFile.h"
+#include "Sgf.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+Perft::Perft(int threads_, uint8_t hash_log2) {
+	threads = std::max(1, threads_);
+	mask = 0;
+	hits = 0;
+	if (hash_log2) {
+		table.reset(new Entry[(size_t) 1 << hash_log2]);
+		mask = ((uint64_t) 1 << hash_log2) - 1;
+		for (uint64_t i = 0; i <= mask; i++) {
+			table[i].check = 0;
+			table[i].data = 0;
+		}
+	}
+}
+
+uint64_t Perft::key(Game &game, int depth) const {
+	return game.zobristHash() ^ (game.side() ? 0 : 0xC2B2AE3D27D4EB4Full)
+			^ (game.passed() ? 0x165667B19E3779F9ull : 0)
+			^ ((uint64_t) depth * 0x9E3779B97F4A7C15ull);
+}
+
+uint64_t Perft::count(Game &game, int depth, uint64_t &moves) {
+	if (depth == 0) {
+		return 1;
+	}
+	if (!game.ongoing()) {
+		return 0;
+	}
+	uint64_t position = 0;
+	if (table) {
+		position = key(game, depth);
+		Entry &entry = table[position & mask];
+		uint64_t data = entry.data.load(std::memory_order_relaxed);
+		if ((entry.check.load(std::memory_order_relaxed) ^ data) == position) {
+			hits++;
+			return data;
+		}
+	}
+
+	const Board &board = game.get_board();
+	int size = board.get_boardsize();
+	bool side = game.side();
+	uint64_t total = 0;
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			int vertex = board.get_vertex(x, y);
+			if (board.get_state((uint16_t) vertex) != Board::EMPTY) {
+				continue;
+			}
+			if (depth == 1) {
+				//the same checks Game::move makes, without playing it
+				if (!board.is_suicide(vertex, side) && game.repeated_board(vertex) < 0) {
+					total++;
+					moves++;
+				}
+				continue;
+			}
+			Game child(game);
+			if (child.move(vertex)) {
+				moves++;
+				total += count(child, depth - 1, moves);
+			}
+		}
+	}
+	moves++; //a pass
+	if (depth == 1) {
+		total++;
+	} else {
+		Game child(game);
+		child.move(Board::PASS);
+		total += count(child, depth - 1, moves);
+	}
+
+	if (table) {
+		Entry &entry = table[position & mask];
+		entry.data.store(total, std::memory_order_relaxed);
+		entry.check.store(position ^ total, std::memory_order_relaxed);
+	}
+	return total;
+}
+
+PerftResult Perft::run(const Game &game, int depth) {
+	auto start = std::chrono::steady_clock::now();
+	PerftResult result = { 0, 0, { }, 0, 0 };
+	hits = 0;
+	Game root(game);
+	std::vector<Game> children;
+	if (depth > 0 && root.ongoing()) {
+		const Board &board = root.get_board();
+		int size = board.get_boardsize();
+		for (int x = 0; x < size; x++) {
+			for (int y = 0; y < size; y++) {
+				Game child(root);
+				if (child.move(board.get_vertex(x, y))) {
+					children.push_back(child);
+					result.divide.push_back( { board.get_vertex(x, y), 0 });
+				}
+			}
+		}
+		children.push_back(root);
+		children.back().move(Board::PASS);
+		result.divide.push_back( { Board::PASS, 0 });
+	}
+
+	std::atomic<size_t> next(0);
+	std::atomic<uint64_t> moves(children.size());
+	auto work = [&] {
+		uint64_t generated = 0;
+		for (size_t i = next++; i < children.size(); i = next++) {
+			result.divide[i].second = count(children[i], depth - 1, generated);
+		}
+		moves += generated;
+	};
+	std::vector<std::thread> helpers;
+	for (int t = 1; t < threads; t++) {
+		helpers.emplace_back(work);
+	}
+	work();
+	for (std::thread &helper : helpers) {
+		helper.join();
+	}
+
+	result.sequences = (depth == 0) ? 1 : 0;
+	for (const std::pair<int, uint64_t> &root_move : result.divide) {
+		result.sequences += root_move.second;
+	}
+	result.moves = moves;
+	result.hash_hits = hits;
+	result.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+Perft::~Perft() {
+}
+
+int perft_main(int argc, char *argv[]) {
+	if (argc < 2) {
+		printf("usage: GoAI perft <boardsize|file.sgf> <depth> [threads] "
+				"[hash log2]\n");
+		return 1;
+	}
+	std::string from = argv[0];
+	std::unique_ptr<Game> game;
+	if (from.find_first_not_of("0123456789") == std::string::npos) {
+		int size = std::stoi(from);
+		if (size < 2 || size > MAX_BOARDSIZE) {
+			printf("unsupported board size %d\n", size);
+			return 1;
+		}
+		game.reset(new Game(size));
+	} else {
+		MappedFile file;
+		if (!file.open(from)) {
+			printf("cannot open %s\n", from.c_str());
+			return 1;
+		}
+		SgfReplay replay([&game](Game &finished) {
+			if (!game) {
+				game.reset(new Game(finished));
+			}
+		});
+		std::string error;
+		if (!sgf_parse(file.data(), file.data() + file.size(), replay, true, error)
+				|| !game) {
+			printf("%s: %s\n", from.c_str(), error.empty() ? "no game" : error.c_str());
+			return 1;
+		}
+	}
+	int depth = std::stoi(argv[1]);
+	int threads = (argc > 2) ? std::stoi(argv[2]) :
+								std::max(1u, std::thread::hardware_concurrency());
+	Perft perft(threads, (argc > 3) ? std::stoi(argv[3]) : 0);
+	PerftResult result = perft.run(*game, depth);
+
+	for (const std::pair<int, uint64_t> &root_move : result.divide) {
+		printf("%-5s %llu\n", root_move.first == Board::PASS ?
+				"pass" : game->move_to_text(root_move.first).c_str(),
+				(unsigned long long) root_move.second);
+	}
+	printf("depth %d: %llu sequences, %llu moves, %llu hash hits, %.2f s, "
+			"%.0f moves/s\n", depth, (unsigned long long) result.sequences,
+			(unsigned long long) result.moves,
+			(unsigned long long) result.hash_hits, result.seconds,
+			result.moves / std::max(result.seconds, 1e-9));
+	return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Perft.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef PERFT_H_
+#define PERFT_H_
+
+#include "Game.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+struct PerftResult {
+	uint64_t sequences; //legal move sequences of the full depth
+	uint64_t moves; //moves generated on the way, for moves/s
+	std::vector<std::pair<int, uint64_t>> divide; //root move, sequences after it
+	uint64_t hash_hits;
+	double seconds;
+};
+
+//counts every legal move sequence of a given length under Game's rules:
+//positional superko, a pass is always legal and two passes end the game.
+//root moves are shared out between threads and the last ply is counted
+//without being played.
+//with a hash table, subtrees are shared between transpositions. the key
+//leaves out the history, so a superko ban that depends on how a position
+//was reached can make the count differ from the plain one
+class Perft {
+public:
+	Perft(int threads, uint8_t hash_log2 = 0); //0 for no table
+
+	PerftResult run(const Game &game, int depth);
+
+	virtual ~Perft();
+private:
+	struct Entry { //check is key ^ data, so a torn entry never matches
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+	int threads;
+	std::unique_ptr<Entry[]> table;
+	uint64_t mask;
+	std::atomic<uint64_t> hits;
+
+	uint64_t count(Game &game, int depth, uint64_t &moves);
+	uint64_t key(Game &game, int depth) const;
+};
+
+//"GoAI perft <boardsize|file.sgf> <depth> [threads] [hash log2]", from the
+//empty board or the end of the first game in the file
+int perft_main(int argc, char *argv[]);
+
+#endif /* PERFT_H_ */
@@ -0,0 +1,79 @@
+/*
+ * Playout.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Playout.h"
+#include <vector>
+
+double playout(Game &game, double komi, std::mt19937 &randGen) {
+	const Board &board = game.get_board();
+	int size = game.get_size();
+	int max_moves = 3 * size * size; //long enough for any sane game
+	static thread_local std::vector<int> candidates;
+	int passes = 0;
+	for (int played = 0; passes < 2 && played < max_moves && game.ongoing();
+			played++) {
+		bool side = game.side();
+		candidates.clear();
+		for (int x = 0; x < size; x++) {
+			for (int y = 0; y < size; y++) {
+				int vertex = game.get_vertex(x, y);
+				if (board.get_state((uint16_t) vertex) == Board::EMPTY
+						&& !board.is_eye(vertex, side) && !game.settled(vertex)) {
+					candidates.push_back(vertex);
+				}
+			}
+		}
+		//draw without replacement until something is legal
+		bool moved = false;
+		while (!candidates.empty() && !moved) {
+			int pick = randGen() % candidates.size();
+			moved = game.move(candidates[pick]);
+			candidates[pick] = candidates.back();
+			candidates.pop_back();
+		}
+		if (moved) {
+			passes = 0;
+		} else if (++passes < 2) {
+			game.move(Board::PASS); //the second pass would only score the game again
+		}
+	}
+	return board.area_score(komi);
+}
+
+double playout(Game &game, double komi, std::mt19937 &randGen,
+		const PatternTable &patterns) {
+	int size = game.get_size();
+	int max_moves = 3 * size * size;
+	static thread_local PatternSampler sampler;
+	sampler.reset(game, patterns);
+	int passes = 0;
+	for (int played = 0; passes < 2 && played < max_moves && game.ongoing();
+			played++) {
+		bool side = game.side();
+		//draw without replacement until something is legal
+		bool moved = false;
+		while (!moved) {
+			int vertex = sampler.sample(side, randGen);
+			if (vertex == Board::PASS) {
+				break;
+			}
+			moved = game.move(vertex);
+			if (!moved) {
+				sampler.exclude(vertex, side);
+			}
+		}
+		sampler.restore();
+		if (moved) {
+			passes = 0;
+			sampler.update(game);
+		} else if (++passes < 2) {
+			game.move(Board::PASS);
+			sampler.reset(game, patterns); //scoring the pass can settle areas
+		}
+	}
+	return game.get_board().area_score(komi);
+}
@@ -0,0 +1,22 @@
+/*
+ * Playout.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef PLAYOUT_H_
+#define PLAYOUT_H_
+
+#include "Game.h"
+#include "Pattern.h"
+#include <random>
+
+//plays random legal moves, never filling a side's own eye or a settled area,
+//until both sides pass. returns the Tromp-Taylor score of the final board
+double playout(Game &game, double komi, std::mt19937 &randGen);
+//the same with moves drawn in proportion to their pattern weights
+double playout(Game &game, double komi, std::mt19937 &randGen,
+		const PatternTable &patterns);
+
+#endif /* PLAYOUT_H_ */
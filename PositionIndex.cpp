@@ -0,0 +1,325 @@
+/*
+ * PositionIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "PositionIndex.h"
+#include "Game.h"
+#include "SelfPlay.h"
+#include "Sgf.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <thread>
+
+uint64_t position_key(const Game &game) {
+	return game.zobristHash()
+			^ (game.get_board().get_boardsize() * 0x165667B19E3779F9ull);
+}
+
+//the positions of one archive, with game numbers local to it
+struct ArchivePositions {
+	std::vector<PositionEntry> entries;
+	uint32_t games = 0;
+	bool readable = true;
+	std::string error;
+};
+
+//collects the positions of each game, keeping them only once the whole
+//game has replayed. the last position comes with the finished game
+class IndexReplay: public SgfReplay {
+public:
+	IndexReplay(ArchivePositions &out_) :
+			SgfReplay([this](Game &game) {
+				add(game);
+				out.games++;
+			}), out(out_) {
+		set_move_callback([this](const Game &game, int, bool) {
+			add(game);
+		});
+	}
+
+	void game_begin() override {
+		SgfReplay::game_begin();
+		game_start = out.entries.size();
+		ply = 0;
+	}
+
+	void game_end() override {
+		uint64_t before = get_games();
+		SgfReplay::game_end();
+		if (get_games() == before) {
+			out.entries.resize(game_start); //it failed part way
+		}
+	}
+private:
+	ArchivePositions &out;
+	size_t game_start = 0;
+	uint16_t ply = 0;
+
+	void add(const Game &game) {
+		out.entries.push_back( { position_key(game), out.games, ply++, 0 });
+	}
+};
+
+static void index_records(RecordReader &reader, ArchivePositions &out) {
+	GameRecord record;
+	while (reader.next(record)) {
+		Game game(reader.get_boardsize());
+		bool side = true;
+		uint16_t ply = 0;
+		for (uint16_t code : record.moves) {
+			out.entries.push_back( { position_key(game), out.games, ply++, 0 });
+			game.play_quiet(record_vertex(game.get_board(), code), side);
+			side = !side;
+		}
+		out.entries.push_back( { position_key(game), out.games, ply, 0 });
+		out.games++;
+	}
+}
+
+static bool index_archive(const std::string &path, ArchivePositions &out) {
+	RecordReader reader;
+	if (reader.open(path)) {
+		index_records(reader, out);
+		return true;
+	}
+	MappedFile file;
+	if (!file.open(path)) {
+		out.error = "cannot open";
+		return false;
+	}
+	IndexReplay replay(out);
+	return sgf_parse(file.data(), file.data() + file.size(), replay, true,
+			out.error);
+}
+
+static bool entry_less(const PositionEntry &a, const PositionEntry &b) {
+	if (a.hash != b.hash) {
+		return a.hash < b.hash;
+	}
+	return a.game != b.game ? a.game < b.game : a.move < b.move;
+}
+
+bool build_position_index(const std::vector<std::string> &archives,
+		const std::string &path, int threads, std::string &error) {
+	std::vector<ArchivePositions> parts(archives.size());
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < std::max(1, threads); t++) {
+		workers.emplace_back([&]() {
+			for (size_t i = next++; i < archives.size(); i = next++) {
+				parts[i].readable = index_archive(archives[i], parts[i]);
+				//sorted here so the merge below is the only serial step
+				std::sort(parts[i].entries.begin(), parts[i].entries.end(),
+						entry_less);
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+
+	//game numbers become global: archives in the order given
+	std::vector<GameSource> sources;
+	std::vector<uint32_t> bases;
+	uint64_t total = 0;
+	for (size_t i = 0; i < parts.size(); i++) {
+		if (!parts[i].readable) {
+			fprintf(stderr, "%s: %s\n", archives[i].c_str(), parts[i].error.c_str());
+		}
+		bases.push_back(sources.size());
+		for (uint32_t g = 0; g < parts[i].games; g++) {
+			sources.push_back( { (uint32_t) i, g });
+		}
+		for (PositionEntry &entry : parts[i].entries) {
+			entry.game += bases[i]; //keeps each part sorted
+		}
+		total += parts[i].entries.size();
+	}
+
+	//one k-way merge of the sorted parts, the next entry of each in a heap
+	std::vector<PositionEntry> entries;
+	entries.reserve(total);
+	std::vector<size_t> taken(parts.size(), 0);
+	auto later = [&parts, &taken](size_t a, size_t b) {
+		return entry_less(parts[b].entries[taken[b]], parts[a].entries[taken[a]]);
+	};
+	std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heads(later);
+	for (size_t i = 0; i < parts.size(); i++) {
+		if (!parts[i].entries.empty()) {
+			heads.push(i);
+		}
+	}
+	while (!heads.empty()) {
+		size_t i = heads.top();
+		heads.pop();
+		entries.push_back(parts[i].entries[taken[i]++]);
+		if (taken[i] < parts[i].entries.size()) {
+			heads.push(i);
+		} else {
+			std::vector<PositionEntry>().swap(parts[i].entries);
+		}
+	}
+
+	std::string names;
+	for (const std::string &archive : archives) {
+		names += archive;
+		names += '\0';
+	}
+	IndexHeader header;
+	memcpy(header.magic, "GOPI", 4);
+	header.version = POSITION_INDEX_VERSION;
+	header.count = entries.size();
+	header.num_games = sources.size();
+	header.num_files = archives.size();
+	header.names_size = names.size();
+	std::ofstream out(path, std::ios::binary);
+	out.write((const char*) &header, sizeof(header));
+	out.write((const char*) entries.data(), entries.size() * sizeof(PositionEntry));
+	out.write((const char*) sources.data(), sources.size() * sizeof(GameSource));
+	out.write(names.data(), names.size());
+	if (!out) {
+		error = "cannot write " + path;
+		return false;
+	}
+	return true;
+}
+
+PositionIndex::PositionIndex() {
+	entries = nullptr;
+	sources = nullptr;
+	count = 0;
+	num_games = 0;
+}
+
+bool PositionIndex::open(const std::string &path) {
+	entries = nullptr;
+	sources = nullptr;
+	names.clear();
+	count = 0;
+	num_games = 0;
+	if (!file.open(path) || file.size() < sizeof(IndexHeader)) {
+		return false;
+	}
+	IndexHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	uint64_t expected = sizeof(header) + header.count * sizeof(PositionEntry)
+			+ (uint64_t) header.num_games * sizeof(GameSource) + header.names_size;
+	if (memcmp(header.magic, "GOPI", 4) != 0
+			|| header.version != POSITION_INDEX_VERSION || file.size() != expected) {
+		file.close();
+		return false;
+	}
+	const char *data = file.data() + sizeof(header);
+	entries = (const PositionEntry*) data;
+	sources = (const GameSource*) (data + header.count * sizeof(PositionEntry));
+	const char *name = (const char*) (sources + header.num_games);
+	const char *names_end = name + header.names_size;
+	while (name < names_end && names.size() < header.num_files) {
+		names.push_back(name);
+		name += strlen(name) + 1;
+	}
+	count = header.count;
+	num_games = header.num_games;
+	return true;
+}
+
+std::pair<const PositionEntry*, const PositionEntry*> PositionIndex::find(
+		uint64_t key) const {
+	const PositionEntry *first = std::lower_bound(entries, entries + count, key,
+			[](const PositionEntry &entry, uint64_t value) {
+				return entry.hash < value;
+			});
+	const PositionEntry *last = first;
+	while (last < entries + count && last->hash == key) {
+		last++;
+	}
+	return {first, last};
+}
+
+const GameSource& PositionIndex::get_source(uint32_t game) const {
+	assert(game < num_games);
+	return sources[game];
+}
+
+const char* PositionIndex::get_file_name(uint32_t file) const {
+	return file < names.size() ? names[file] : "?";
+}
+
+uint64_t PositionIndex::size() const {
+	return count;
+}
+
+uint32_t PositionIndex::get_games() const {
+	return num_games;
+}
+
+PositionIndex::~PositionIndex() {
+}
+
+int index_main(int argc, char *argv[]) {
+	std::string command = (argc > 0) ? argv[0] : "";
+	if (command == "build" && argc > 2) {
+		std::vector<std::string> archives(argv + 2, argv + argc);
+		int threads = std::max(1u, std::thread::hardware_concurrency());
+		std::string error;
+		auto start = std::chrono::steady_clock::now();
+		if (!build_position_index(archives, argv[1], threads, error)) {
+			printf("%s\n", error.c_str());
+			return 1;
+		}
+		double seconds = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		PositionIndex index;
+		index.open(argv[1]);
+		printf("%u games, %llu positions indexed in %.2f s\n", index.get_games(),
+				(unsigned long long) index.size(), seconds);
+		return 0;
+	}
+	if (command == "query" && argc > 2) {
+		PositionIndex index;
+		if (!index.open(argv[1])) {
+			printf("cannot open index %s\n", argv[1]);
+			return 1;
+		}
+		int size = std::stoi(argv[2]);
+		if (size < 2 || size > MAX_BOARDSIZE) {
+			printf("unsupported board size %d\n", size);
+			return 1;
+		}
+		Game game(size);
+		for (int i = 3; i < argc; i++) {
+			std::string text = argv[i];
+			int move = (text == "pass") ? Board::PASS : game.text_to_move(text);
+			if (!game.move(move)) {
+				printf("illegal move %s\n", argv[i]);
+				return 1;
+			}
+		}
+		auto start = std::chrono::steady_clock::now();
+		//the key holds the size, so only games of this size match
+		std::pair<const PositionEntry*, const PositionEntry*> found = index.find(
+				position_key(game));
+		double micros = std::chrono::duration<double, std::micro>(
+				std::chrono::steady_clock::now() - start).count();
+		for (const PositionEntry *entry = found.first; entry != found.second;
+				entry++) {
+			const GameSource &source = index.get_source(entry->game);
+			printf("%s game %u move %u\n", index.get_file_name(source.file),
+					source.ordinal, entry->move);
+		}
+		printf("%ld occurrences, %.1f us\n", (long) (found.second - found.first),
+				micros);
+		return 0;
+	}
+	printf("usage: GoAI index build <out> <archive>...\n"
+			"       GoAI index query <index> <boardsize> [move]...\n");
+	return 1;
+}
@@ -0,0 +1,81 @@
+/*
+ * PositionIndex.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef POSITIONINDEX_H_
+#define POSITIONINDEX_H_
+
+#include "Game.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define POSITION_INDEX_VERSION 2
+
+//file layout: an IndexHeader, count PositionEntry sorted by hash, game and
+//move, num_games GameSource, then the archive names, each ending in '\0'
+struct IndexHeader {
+	char magic[4]; //"GOPI"
+	uint32_t version;
+	uint64_t count;
+	uint32_t num_games;
+	uint32_t num_files;
+	uint64_t names_size;
+};
+
+struct PositionEntry {
+	uint64_t hash; //position_key() of the position
+	uint32_t game;
+	uint16_t move; //moves played before the position was reached
+	uint16_t reserved;
+};
+
+struct GameSource {
+	uint32_t file; //index into the archive names
+	uint32_t ordinal; //game number inside that archive, from 0
+};
+
+//Game::zobristHash() with the board size mixed in. the hash alone is 0 for
+//every empty board and aliases vertex indices between sizes
+uint64_t position_key(const Game &game);
+
+//replays SGF archives and self-play record files and writes an index of
+//every position every game went through. archives are read in parallel
+bool build_position_index(const std::vector<std::string> &archives,
+		const std::string &path, int threads, std::string &error);
+
+//a built index, mapped read-only
+class PositionIndex {
+public:
+	PositionIndex();
+
+	bool open(const std::string &path);
+	//every occurrence of the position, ordered by game and move. no allocation
+	std::pair<const PositionEntry*, const PositionEntry*> find(uint64_t key) const;
+
+	const GameSource& get_source(uint32_t game) const;
+	const char* get_file_name(uint32_t file) const;
+
+	uint64_t size() const;
+	uint32_t get_games() const;
+
+	virtual ~PositionIndex();
+private:
+	MappedFile file;
+	const PositionEntry *entries;
+	const GameSource *sources;
+	std::vector<const char*> names;
+	uint64_t count;
+	uint32_t num_games;
+};
+
+//"GoAI index build <out> <archive>..." or
+//"GoAI index query <index> <boardsize> [move]..." for the position after the moves
+int index_main(int argc, char *argv[]);
+
+#endif /* POSITIONINDEX_H_ */
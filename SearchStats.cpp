@@ -0,0 +1,153 @@
+/*
+ * SearchStats.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "SearchStats.h"
+#include "AI.h"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+void SearchStats::add(const SearchStats &other) {
+	nodes += other.nodes;
+	leaf_evaluations += other.leaf_evaluations;
+	cutoffs += other.cutoffs;
+	first_move_cutoffs += other.first_move_cutoffs;
+	tt_probes += other.tt_probes;
+	tt_hits += other.tt_hits;
+	cache_probes += other.cache_probes;
+	cache_hits += other.cache_hits;
+	searches += other.searches;
+	seconds += other.seconds;
+}
+
+double SearchStats::first_move_cutoff_rate() const {
+	return cutoffs ? (double) first_move_cutoffs / cutoffs : 0;
+}
+
+double SearchStats::tt_hit_rate() const {
+	return tt_probes ? (double) tt_hits / tt_probes : 0;
+}
+
+double SearchStats::cache_hit_rate() const {
+	return cache_probes ? (double) cache_hits / cache_probes : 0;
+}
+
+SearchCounters::SearchCounters() {
+	for (std::atomic<uint64_t> &field : fields) {
+		field = 0;
+	}
+}
+
+void SearchCounters::publish(const SearchStats &running) {
+	SearchStats total = done;
+	total.add(running);
+	store(total);
+}
+
+void SearchCounters::finish(const SearchStats &search) {
+	done.add(search);
+	store(done);
+}
+
+void SearchCounters::store(const SearchStats &total) {
+	fields[NODES].store(total.nodes, std::memory_order_relaxed);
+	fields[LEAVES].store(total.leaf_evaluations, std::memory_order_relaxed);
+	fields[CUTOFFS].store(total.cutoffs, std::memory_order_relaxed);
+	fields[FIRST_CUTOFFS].store(total.first_move_cutoffs, std::memory_order_relaxed);
+	fields[TT_PROBES].store(total.tt_probes, std::memory_order_relaxed);
+	fields[TT_HITS].store(total.tt_hits, std::memory_order_relaxed);
+	fields[CACHE_PROBES].store(total.cache_probes, std::memory_order_relaxed);
+	fields[CACHE_HITS].store(total.cache_hits, std::memory_order_relaxed);
+	fields[SEARCHES].store(total.searches, std::memory_order_relaxed);
+	fields[NANOSECONDS].store((uint64_t) (total.seconds * 1e9),
+			std::memory_order_relaxed);
+}
+
+SearchStats SearchCounters::read() const {
+	SearchStats out;
+	out.nodes = fields[NODES].load(std::memory_order_relaxed);
+	out.leaf_evaluations = fields[LEAVES].load(std::memory_order_relaxed);
+	out.cutoffs = fields[CUTOFFS].load(std::memory_order_relaxed);
+	out.first_move_cutoffs = fields[FIRST_CUTOFFS].load(std::memory_order_relaxed);
+	out.tt_probes = fields[TT_PROBES].load(std::memory_order_relaxed);
+	out.tt_hits = fields[TT_HITS].load(std::memory_order_relaxed);
+	out.cache_probes = fields[CACHE_PROBES].load(std::memory_order_relaxed);
+	out.cache_hits = fields[CACHE_HITS].load(std::memory_order_relaxed);
+	out.searches = fields[SEARCHES].load(std::memory_order_relaxed);
+	out.seconds = fields[NANOSECONDS].load(std::memory_order_relaxed) * 1e-9;
+	return out;
+}
+
+SearchCounters::~SearchCounters() {
+}
+
+//counters outlive their threads, so totals stay readable after a worker exits
+static std::mutex registry_mutex;
+static std::vector<std::shared_ptr<SearchCounters>> registry;
+
+SearchCounters& thread_search_counters() {
+	static thread_local std::shared_ptr<SearchCounters> counters;
+	if (!counters) {
+		counters = std::make_shared<SearchCounters>();
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		registry.push_back(counters);
+	}
+	return *counters;
+}
+
+std::vector<ThreadSearchStats> search_statistics() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	std::vector<ThreadSearchStats> out;
+	for (size_t i = 0; i < registry.size(); i++) {
+		out.push_back( { (int) i, registry[i]->read() });
+	}
+	return out;
+}
+
+std::string search_stats_json(const SearchStats &stats) {
+	char text[512];
+	snprintf(text, sizeof(text), "{\"nodes\": %llu, \"leaf_evaluations\": %llu, "
+			"\"cutoffs\": %llu, \"first_move_cutoff_rate\": %.4f, "
+			"\"tt_probes\": %llu, \"tt_hit_rate\": %.4f, \"cache_probes\": %llu, "
+			"\"cache_hit_rate\": %.4f, \"searches\": %llu, \"seconds\": %.3f}",
+			(unsigned long long) stats.nodes,
+			(unsigned long long) stats.leaf_evaluations,
+			(unsigned long long) stats.cutoffs, stats.first_move_cutoff_rate(),
+			(unsigned long long) stats.tt_probes, stats.tt_hit_rate(),
+			(unsigned long long) stats.cache_probes, stats.cache_hit_rate(),
+			(unsigned long long) stats.searches, stats.seconds);
+	return text;
+}
+
+std::string search_result_json(const SearchResult &result) {
+	char text[160];
+	snprintf(text, sizeof(text), "{\"depth\": %d, \"branching_factor\": %.3f, ",
+			result.depth, result.branching_factor);
+	std::string out = text;
+	out += "\"stats\": " + search_stats_json(result.stats) + ", \"iterations\": [";
+	for (size_t i = 0; i < result.iterations.size(); i++) {
+		const IterationStats &iteration = result.iterations[i];
+		snprintf(text, sizeof(text),
+				"%s{\"depth\": %d, \"nodes\": %llu, \"leaf_evaluations\": %llu, "
+						"\"seconds\": %.4f}", i ? ", " : "", iteration.depth,
+				(unsigned long long) iteration.nodes,
+				(unsigned long long) iteration.leaf_evaluations, iteration.seconds);
+		out += text;
+	}
+	return out + "]}";
+}
+
+std::string search_threads_json() {
+	std::string out = "[";
+	std::vector<ThreadSearchStats> threads = search_statistics();
+	for (size_t i = 0; i < threads.size(); i++) {
+		std::string stats = search_stats_json(threads[i].stats);
+		out += (i ? ", {\"thread\": " : "{\"thread\": ")
+				+ std::to_string(threads[i].thread) + ", " + stats.substr(1);
+	}
+	return out + "]";
+}
@@ -0,0 +1,89 @@
+/*
+ * SearchStats.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef SEARCHSTATS_H_
+#define SEARCHSTATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SearchResult;
+
+struct SearchStats {
+	uint64_t nodes = 0; //minimax calls
+	uint64_t leaf_evaluations = 0; //positions scored, cached or not
+	uint64_t cutoffs = 0; //beta cutoffs
+	uint64_t first_move_cutoffs = 0; //cutoffs by the first move tried
+	uint64_t tt_probes = 0;
+	uint64_t tt_hits = 0;
+	uint64_t cache_probes = 0; //leaf cache
+	uint64_t cache_hits = 0;
+	uint64_t searches = 0;
+	double seconds = 0;
+
+	void add(const SearchStats &other);
+	double first_move_cutoff_rate() const; //share of cutoffs, 0 without any
+	double tt_hit_rate() const;
+	double cache_hit_rate() const;
+};
+
+struct IterationStats {
+	int depth;
+	uint64_t nodes; //this iteration alone
+	uint64_t leaf_evaluations;
+	double seconds;
+};
+
+//totals of every search one thread has run. only the owner writes them, as
+//relaxed loads and stores with no locked instruction, and any thread can
+//read them while searches run
+class SearchCounters {
+public:
+	SearchCounters();
+
+	void publish(const SearchStats &running); //what the current search has so far
+	void finish(const SearchStats &search); //a search is over
+	SearchStats read() const;
+
+	virtual ~SearchCounters();
+private:
+	enum {
+		NODES,
+		LEAVES,
+		CUTOFFS,
+		FIRST_CUTOFFS,
+		TT_PROBES,
+		TT_HITS,
+		CACHE_PROBES,
+		CACHE_HITS,
+		SEARCHES,
+		NANOSECONDS,
+		FIELDS
+	};
+	SearchStats done; //finished searches, owner only
+	std::atomic<uint64_t> fields[FIELDS];
+
+	void store(const SearchStats &total);
+};
+
+SearchCounters& thread_search_counters(); //registers the calling thread on first use
+
+struct ThreadSearchStats {
+	int thread; //in order of first search
+	SearchStats stats;
+};
+
+std::vector<ThreadSearchStats> search_statistics(); //live, one entry per search thread
+
+std::string search_stats_json(const SearchStats &stats);
+//the stats of one search along with its depth, branching factor and iterations
+std::string search_result_json(const SearchResult &result);
+std::string search_threads_json(); //search_statistics() as an array
+
+#endif /* SEARCHSTATS_H_ */
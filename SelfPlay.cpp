@@ -0,0 +1,387 @@
+/*
+ * SelfPlay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "SelfPlay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+
+static int code_bits(uint8_t board_size) {
+	//codes run from 0 to size * size, the pass
+	int bits = 1;
+	while ((1 << bits) <= board_size * board_size) {
+		bits++;
+	}
+	return bits;
+}
+
+template<typename T>
+static void put(std::vector<char> &out, T value) {
+	char bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static T get(const char *&pos) {
+	T value;
+	memcpy(&value, pos, sizeof(T));
+	pos += sizeof(T);
+	return value;
+}
+
+static int16_t half_points(double score) {
+	return (int16_t) std::max(-32768.0, std::min(32767.0, std::round(score * 2)));
+}
+
+uint16_t record_move(const Board &board, int move) {
+	int size = board.get_boardsize();
+	if (move == Board::PASS) {
+		return size * size;
+	}
+	std::pair<uint8_t, uint8_t> xy = board.get_xy(move);
+	return xy.first * size + xy.second;
+}
+
+int record_vertex(const Board &board, uint16_t code) {
+	int size = board.get_boardsize();
+	if (code == size * size) {
+		return Board::PASS;
+	}
+	return board.get_vertex(code / size, code % size);
+}
+
+void encode_record(const GameRecord &record, uint8_t board_size, bool stats,
+		std::vector<char> &out) {
+	size_t start = out.size();
+	put<uint16_t>(out, 0); //payload length, filled in at the end
+	put<uint16_t>(out, record.moves.size());
+	put<int16_t>(out, half_points(record.score));
+	int bits = code_bits(board_size);
+	uint32_t pending = 0;
+	int pending_bits = 0;
+	for (uint16_t code : record.moves) {
+		pending |= (uint32_t) code << pending_bits;
+		pending_bits += bits;
+		while (pending_bits >= 8) {
+			out.push_back((char) (pending & 0xFF));
+			pending >>= 8;
+			pending_bits -= 8;
+		}
+	}
+	if (pending_bits > 0) {
+		out.push_back((char) pending);
+	}
+	if (stats) {
+		for (const MoveStats &move : record.stats) {
+			put<uint8_t>(out, move.depth);
+			put<int16_t>(out, move.score);
+			put<uint32_t>(out, move.nodes);
+		}
+	}
+	uint16_t length = out.size() - start - sizeof(uint16_t);
+	memcpy(&out[start], &length, sizeof(length));
+}
+
+bool decode_record(const char *&pos, const char *end, uint8_t board_size,
+		bool stats, GameRecord &out) {
+	if (end - pos < 6) {
+		return false;
+	}
+	const char *cursor = pos;
+	uint16_t length = get<uint16_t>(cursor);
+	const char *record_end = cursor + length;
+	if (length < 4 || record_end > end) {
+		return false;
+	}
+	uint16_t num_moves = get<uint16_t>(cursor);
+	out.score = get<int16_t>(cursor) / 2.0;
+	int bits = code_bits(board_size);
+	size_t packed = (num_moves * bits + 7) / 8;
+	if (length != 4 + packed + (stats ? num_moves * 7 : 0)) {
+		return false;
+	}
+	out.moves.resize(num_moves);
+	uint32_t pending = 0;
+	int pending_bits = 0;
+	for (uint16_t &code : out.moves) {
+		while (pending_bits < bits) {
+			pending |= (uint32_t) (uint8_t) *cursor++ << pending_bits;
+			pending_bits += 8;
+		}
+		code = pending & ((1u << bits) - 1);
+		pending >>= bits;
+		pending_bits -= bits;
+		if (code > board_size * board_size) {
+			return false;
+		}
+	}
+	cursor = pos + 6 + packed; //past the padding of the last byte
+	out.stats.clear();
+	if (stats) {
+		out.stats.resize(num_moves);
+		for (MoveStats &move : out.stats) {
+			move.depth = get<uint8_t>(cursor);
+			move.score = get<int16_t>(cursor);
+			move.nodes = get<uint32_t>(cursor);
+		}
+	}
+	pos = record_end;
+	return true;
+}
+
+RecordWriter::RecordWriter() {
+	file = nullptr;
+	failed = false;
+}
+
+bool RecordWriter::open(const std::string &path, uint8_t board_size,
+		bool stats) {
+	close();
+	RecordHeader header;
+	memcpy(header.magic, "GOSP", 4);
+	header.version = SELFPLAY_VERSION;
+	header.board_size = board_size;
+	header.flags = stats ? SELFPLAY_STATS : 0;
+	header.reserved = 0;
+
+	//an existing file is only extended if its records are alike
+	RecordHeader existing;
+	std::FILE *check = std::fopen(path.c_str(), "rb");
+	bool empty = true;
+	if (check) {
+		size_t read = std::fread(&existing, 1, sizeof(existing), check);
+		std::fclose(check);
+		empty = (read == 0);
+		if (!empty && (read != sizeof(existing)
+				|| memcmp(&existing, &header, sizeof(header)) != 0)) {
+			return false;
+		}
+	}
+	file = std::fopen(path.c_str(), "ab");
+	if (!file) {
+		return false;
+	}
+	failed = false;
+	if (empty) {
+		failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+	}
+	buffer.reserve(SELFPLAY_BUFFER);
+	return !failed;
+}
+
+void RecordWriter::append(const std::vector<char> &record) {
+	std::lock_guard<std::mutex> lock(mutex);
+	buffer.insert(buffer.end(), record.begin(), record.end());
+	if (buffer.size() >= SELFPLAY_BUFFER && file) {
+		failed |= std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size();
+		buffer.clear();
+	}
+}
+
+bool RecordWriter::flush() {
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!file) {
+		return false;
+	}
+	failed |= std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size();
+	buffer.clear();
+	failed |= std::fflush(file) != 0;
+	return !failed;
+}
+
+void RecordWriter::close() {
+	if (file) {
+		flush();
+		std::fclose(file);
+		file = nullptr;
+	}
+}
+
+RecordWriter::~RecordWriter() {
+	close();
+}
+
+RecordReader::RecordReader() {
+	pos = nullptr;
+	end = nullptr;
+	board_size = 0;
+	stats = false;
+}
+
+bool RecordReader::open(const std::string &path) {
+	pos = end = nullptr;
+	if (!file.open(path) || file.size() < sizeof(RecordHeader)) {
+		return false;
+	}
+	RecordHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	if (memcmp(header.magic, "GOSP", 4) != 0 || header.version != SELFPLAY_VERSION
+			|| header.board_size < 2 || header.board_size > MAX_BOARDSIZE) {
+		file.close();
+		return false;
+	}
+	board_size = header.board_size;
+	stats = header.flags & SELFPLAY_STATS;
+	pos = file.data() + sizeof(header);
+	end = file.data() + file.size();
+	return true;
+}
+
+bool RecordReader::next(GameRecord &record) {
+	return pos && decode_record(pos, end, board_size, stats, record);
+}
+
+uint8_t RecordReader::get_boardsize() const {
+	return board_size;
+}
+
+bool RecordReader::has_stats() const {
+	return stats;
+}
+
+RecordReader::~RecordReader() {
+}
+
+int random_move(Game &game, std::mt19937 &randGen) {
+	//the playout policy for a single move: no own eyes, nothing settled
+	static thread_local std::vector<int> candidates;
+	const Board &board = game.get_board();
+	bool side = game.side();
+	int size = game.get_size();
+	candidates.clear();
+	for (int x = 0; x < size; x++) {
+		for (int y = 0; y < size; y++) {
+			int vertex = game.get_vertex(x, y);
+			if (board.get_state((uint16_t) vertex) == Board::EMPTY
+					&& !board.is_eye(vertex, side) && !game.settled(vertex)) {
+				candidates.push_back(vertex);
+			}
+		}
+	}
+	while (!candidates.empty()) {
+		int pick = randGen() % candidates.size();
+		Game test(game);
+		if (test.move(candidates[pick])) {
+			return candidates[pick];
+		}
+		candidates[pick] = candidates.back();
+		candidates.pop_back();
+	}
+	return Board::PASS;
+}
+
+static void play_game(const Game &empty, const SelfPlayConfig &config,
+		std::mt19937 &randGen, GameRecord &record) {
+	Game game(empty);
+	const Board &board = game.get_board();
+	int max_moves = 3 * config.board_size * config.board_size;
+	record.moves.clear();
+	record.stats.clear();
+	while (game.ongoing() && (int) record.moves.size() < max_moves) {
+		int move;
+		MoveStats stats = { 0, 0, 0 };
+		if ((int) record.moves.size() < config.random_plies) {
+			move = random_move(game, randGen);
+		} else {
+			SearchResult result = search(game, config.limits);
+			move = result.move;
+			stats.depth = result.depth;
+			stats.score = half_points(result.score);
+			stats.nodes = (uint32_t) std::min<uint64_t>(result.nodes, UINT32_MAX);
+		}
+		if (!game.move(move)) {
+			move = Board::PASS; //search only returns legal moves, this is a safety net
+			game.move(move);
+		}
+		record.moves.push_back(record_move(board, move));
+		if (config.stats) {
+			record.stats.push_back(stats);
+		}
+	}
+	record.score = game.final_score(config.komi);
+}
+
+int run_selfplay(const SelfPlayConfig &config, const std::string &path) {
+	RecordWriter writer;
+	if (!writer.open(path, config.board_size, config.stats)) {
+		fprintf(stderr, "cannot append to %s\n", path.c_str());
+		return 1;
+	}
+	//workers copy one prepared game instead of building their own each time
+	Game empty(config.board_size);
+	empty.set_komi(config.komi);
+
+	std::atomic<int> next(0), finished(0), black_wins(0);
+	std::atomic<uint64_t> moves(0);
+	auto start = std::chrono::steady_clock::now();
+	int report_every = std::max(1, config.games / 20);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < config.threads; t++) {
+		workers.emplace_back([&]() {
+			std::mt19937 randGen;
+			GameRecord record;
+			std::vector<char> bytes;
+			for (int i = next++; i < config.games; i = next++) {
+				randGen.seed(config.seed + i); //the same openings whatever the thread count
+				play_game(empty, config, randGen, record);
+				bytes.clear();
+				encode_record(record, config.board_size, config.stats, bytes);
+				writer.append(bytes);
+				moves += record.moves.size();
+				black_wins += record.score > 0;
+				int done = ++finished;
+				if (done % report_every == 0) {
+					double seconds = std::chrono::duration<double>(
+							std::chrono::steady_clock::now() - start).count();
+					fprintf(stderr, "%d/%d games, %.0f games/hour\n", done,
+							config.games, done * 3600 / seconds);
+				}
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	if (!writer.flush()) {
+		fprintf(stderr, "write to %s failed\n", path.c_str());
+		return 1;
+	}
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	printf("%d games, %llu moves, black won %d\n", finished.load(),
+			(unsigned long long) moves.load(), black_wins.load());
+	printf("%.2f s, %.0f games/hour, %.0f moves/s\n", seconds,
+			finished * 3600 / seconds, moves / seconds);
+	return 0;
+}
+
+int selfplay_main(int argc, char *argv[]) {
+	if (argc < 2) {
+		printf("usage: GoAI selfplay <out> <games> [boardsize] [depth] "
+				"[random plies] [threads] [stats]\n");
+		return 1;
+	}
+	SelfPlayConfig config;
+	config.games = std::stoi(argv[1]);
+	int size = (argc > 2) ? std::stoi(argv[2]) : 9;
+	config.limits.depth = (argc > 3) ? std::stoi(argv[3]) : 1;
+	config.random_plies = (argc > 4) ? std::stoi(argv[4]) : 4;
+	config.threads = (argc > 5) ? std::stoi(argv[5]) :
+						std::max(1u, std::thread::hardware_concurrency());
+	config.stats = (argc > 6) && std::stoi(argv[6]) != 0;
+	if (size < 2 || size > MAX_BOARDSIZE) {
+		printf("unsupported board size %d\n", size);
+		return 1;
+	}
+	config.board_size = size;
+	return run_selfplay(config, argv[0]);
+}
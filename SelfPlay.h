@@ -0,0 +1,118 @@
+/*
+ * SelfPlay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef SELFPLAY_H_
+#define SELFPLAY_H_
+
+#include "AI.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#define SELFPLAY_VERSION 1
+#define SELFPLAY_STATS 1 //header flag: every move carries MoveStats
+#define SELFPLAY_BUFFER (1 << 20) //bytes gathered before a write
+
+//file layout: a RecordHeader, then records appended one after another.
+//a record is its payload length (uint16), the number of moves (uint16),
+//the final score in half points (int16, black's point of view), the moves
+//bit-packed with just enough bits for size * size + 1 codes, and with
+//SELFPLAY_STATS 7 bytes of stats per move. everything is little endian
+struct RecordHeader {
+	char magic[4]; //"GOSP"
+	uint8_t version;
+	uint8_t board_size;
+	uint8_t flags;
+	uint8_t reserved;
+};
+
+struct MoveStats {
+	uint8_t depth;
+	int16_t score; //half points, black's point of view
+	uint32_t nodes;
+};
+
+struct GameRecord {
+	std::vector<uint16_t> moves; //x * size + y, size * size for a pass
+	double score; //black minus white minus komi
+	std::vector<MoveStats> stats; //empty unless recorded
+};
+
+uint16_t record_move(const Board &board, int move); //vertex or PASS to a record code
+int record_vertex(const Board &board, uint16_t code);
+
+void encode_record(const GameRecord &record, uint8_t board_size, bool stats,
+		std::vector<char> &out); //appends
+bool decode_record(const char *&pos, const char *end, uint8_t board_size,
+		bool stats, GameRecord &out);
+
+//append-only record file shared by several threads. records are buffered
+//and written in large blocks
+class RecordWriter {
+public:
+	RecordWriter();
+
+	//appends to an existing file with the same size and flags
+	bool open(const std::string &path, uint8_t board_size, bool stats);
+	void append(const std::vector<char> &record);
+	bool flush();
+	void close();
+
+	virtual ~RecordWriter();
+private:
+	std::mutex mutex;
+	std::FILE *file;
+	std::vector<char> buffer;
+	bool failed;
+};
+
+class RecordReader {
+public:
+	RecordReader();
+
+	bool open(const std::string &path);
+	bool next(GameRecord &record); //false at the end or on a damaged record
+
+	uint8_t get_boardsize() const;
+	bool has_stats() const;
+
+	virtual ~RecordReader();
+private:
+	MappedFile file;
+	const char *pos;
+	const char *end;
+	uint8_t board_size;
+	bool stats;
+};
+
+//a legal move at random, never into an own eye or a settled area. PASS
+//when there is none
+int random_move(Game &game, std::mt19937 &randGen);
+
+struct SelfPlayConfig {
+	uint8_t board_size = 9;
+	int games = 100;
+	int threads = 1;
+	SearchLimits limits; //per move
+	int random_plies = 4; //opening moves drawn at random, for variety
+	double komi = 7;
+	bool stats = false;
+	uint32_t seed = 1;
+};
+
+//plays config.games games on config.threads persistent workers, each game
+//picking a move with search() and written as soon as it ends
+int run_selfplay(const SelfPlayConfig &config, const std::string &path);
+
+//"GoAI selfplay <out> <games> [boardsize] [depth] [random plies] [threads] [stats]"
+int selfplay_main(int argc, char *argv[]);
+
+#endif /* SELFPLAY_H_ */
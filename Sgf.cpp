@@ -0,0 +1,351 @@
+/*
+ * Sgf.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Sgf.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+SgfVisitor::~SgfVisitor() {
+}
+
+//p is just past the '[', returns the closing ']' or end
+static const char* value_end(const char *p, const char *end) {
+	while (p < end && *p != ']') {
+		p += (*p == '\\') ? 2 : 1;
+	}
+	return std::min(p, end);
+}
+
+//p is on a '(', returns just past its matching ')'
+static const char* skip_tree(const char *p, const char *end) {
+	int depth = 0;
+	while (p < end) {
+		if (*p == '[') {
+			p = value_end(p + 1, end);
+		} else if (*p == '(') {
+			depth++;
+		} else if (*p == ')' && --depth == 0) {
+			return p + 1;
+		}
+		p++;
+	}
+	return end;
+}
+
+bool sgf_parse(const char *begin, const char *end, SgfVisitor &visitor,
+		bool main_line_only, std::string &error) {
+	//explicit stack instead of recursion, some editors nest every move
+	struct Tree {
+		bool main_line;
+		int children;
+	};
+	std::vector<Tree> trees;
+	bool in_node = false;
+	const char *p = begin;
+	while (p < end) {
+		char c = *p;
+		if (trees.empty()) {
+			//anything between game trees is ignored
+			if (c == '(') {
+				visitor.game_begin();
+				trees.push_back( { true, 0 });
+			}
+			p++;
+			continue;
+		}
+		if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+			p++;
+		} else if (c == ';') {
+			if (in_node) {
+				visitor.node_end();
+			}
+			visitor.node_begin(trees.back().main_line);
+			in_node = true;
+			p++;
+		} else if (c == '(') {
+			if (in_node) {
+				visitor.node_end();
+				in_node = false;
+			}
+			Tree &parent = trees.back();
+			bool main_line = parent.main_line && parent.children == 0;
+			parent.children++;
+			if (main_line_only && !main_line) {
+				p = skip_tree(p, end);
+				continue;
+			}
+			visitor.variation_begin(main_line);
+			trees.push_back( { main_line, 0 });
+			p++;
+		} else if (c == ')') {
+			if (in_node) {
+				visitor.node_end();
+				in_node = false;
+			}
+			trees.pop_back();
+			if (trees.empty()) {
+				visitor.game_end();
+			} else {
+				visitor.variation_end();
+			}
+			p++;
+		} else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+			if (!in_node) {
+				error = "property outside a node at byte " + std::to_string(p - begin);
+				return false;
+			}
+			const char *name = p;
+			while (p < end && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) {
+				p++;
+			}
+			std::string_view ident(name, p - name);
+			int values = 0;
+			while (true) {
+				while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+					p++;
+				}
+				if (p >= end || *p != '[') {
+					break;
+				}
+				const char *close = value_end(p + 1, end);
+				if (close >= end) {
+					error = "unterminated value at byte " + std::to_string(p - begin);
+					return false;
+				}
+				visitor.property(ident, std::string_view(p + 1, close - p - 1));
+				values++;
+				p = close + 1;
+			}
+			if (!values) {
+				error = "property without a value at byte " + std::to_string(name - begin);
+				return false;
+			}
+		} else {
+			error = std::string("unexpected '") + c + "' at byte "
+					+ std::to_string(p - begin);
+			return false;
+		}
+	}
+	if (!trees.empty()) {
+		error = "unterminated game tree";
+		return false;
+	}
+	return true;
+}
+
+std::string sgf_text(std::string_view value) {
+	std::string out;
+	out.reserve(value.size());
+	for (size_t i = 0; i < value.size(); i++) {
+		if (value[i] == '\\' && i + 1 < value.size()) {
+			i++;
+			if (value[i] == '\n' || value[i] == '\r') {
+				//a soft line break, "\r\n" counts as one
+				if (i + 1 < value.size() && value[i] == '\r' && value[i + 1] == '\n') {
+					i++;
+				}
+				continue;
+			}
+		}
+		out += value[i];
+	}
+	return out;
+}
+
+SgfReplay::SgfReplay(std::function<void(Game&)> on_game_) {
+	on_game = on_game_;
+	board_size = 19;
+	komi = 0;
+	failed = false;
+	in_main_line = false;
+	winner = 0;
+	games = 0;
+	moves = 0;
+	failures = 0;
+}
+
+void SgfReplay::game_begin() {
+	game.reset();
+	pending.clear();
+	board_size = 19; //the SGF default
+	komi = 0;
+	failed = false;
+	winner = 0;
+}
+
+void SgfReplay::node_begin(bool main_line) {
+	in_main_line = main_line;
+	pending.clear();
+}
+
+void SgfReplay::property(std::string_view name, std::string_view value) {
+	if (!in_main_line || failed || name.size() > 2) {
+		return;
+	}
+	if (name == "B" || name == "W") {
+		pending.push_back( { name[0], value });
+	} else if (name == "AB" || name == "AW") {
+		pending.push_back( { (char) (name[1] == 'B' ? 'b' : 'w'), value });
+	} else if (name == "SZ" && !game) {
+		board_size = atoi(std::string(value).c_str()); //"19" or "19:19"
+	} else if (name == "RE") {
+		winner = (value.size() > 1 && value[1] == '+'
+				&& (value[0] == 'B' || value[0] == 'W')) ? value[0] : 0;
+	} else if (name == "KM") {
+		komi = atof(std::string(value).c_str());
+		if (game) {
+			game->set_komi(komi);
+		}
+	}
+}
+
+void SgfReplay::node_end() {
+	if (!in_main_line || failed) {
+		return;
+	}
+	//the board size can come after the first stones of the root node, so
+	//the game is made once the whole node has been read
+	if (!game) {
+		if (board_size < 2 || board_size > MAX_BOARDSIZE) {
+			failed = true;
+			return;
+		}
+		game.reset(new Game(board_size));
+		game->set_komi(komi);
+	}
+	for (const Pending &item : pending) {
+		if (item.kind == 'b' || item.kind == 'w') {
+			setup(item.value, item.kind == 'b');
+			continue;
+		}
+		const Board &board = game->get_board();
+		int move = (item.value.size() < 2) ? Board::PASS : //empty value is a pass
+					board.sgf_vertex(item.value[0], item.value[1]);
+		if (move != NUM_VERTICES && on_move) {
+			on_move(*game, move, item.kind == 'B');
+		}
+		if (move == NUM_VERTICES || !game->play_quiet(move, item.kind == 'B')) {
+			failed = true;
+			return;
+		}
+		moves++;
+	}
+}
+
+void SgfReplay::setup(std::string_view value, bool side) {
+	//a point, or "aa:cc" for every point of a rectangle
+	const Board &board = game->get_board();
+	if (value.size() < 2) {
+		return;
+	}
+	char first_column = value[0], first_row = value[1];
+	char last_column = first_column, last_row = first_row;
+	if (value.size() == 5 && value[2] == ':') {
+		last_column = value[3];
+		last_row = value[4];
+	}
+	for (char column = first_column; column <= last_column; column++) {
+		for (char row = first_row; row <= last_row; row++) {
+			int vertex = board.sgf_vertex(column, row);
+			if (vertex == NUM_VERTICES || vertex == Board::PASS) {
+				failed = true;
+				return;
+			}
+			game->setup(vertex, side);
+		}
+	}
+}
+
+void SgfReplay::game_end() {
+	if (!game && !failed) {
+		node_end(); //a game tree with no nodes at all still makes an empty game
+	}
+	if (failed || !game) {
+		failures++;
+	} else {
+		games++;
+		if (on_game) {
+			on_game(*game);
+		}
+	}
+	game.reset();
+}
+
+void SgfReplay::set_move_callback(
+		std::function<void(const Game&, int, bool)> on_move_) {
+	on_move = on_move_;
+}
+
+char SgfReplay::get_winner() const {
+	return winner;
+}
+
+uint64_t SgfReplay::get_games() const {
+	return games;
+}
+
+uint64_t SgfReplay::get_moves() const {
+	return moves;
+}
+
+uint64_t SgfReplay::get_failures() const {
+	return failures;
+}
+
+SgfReplay::~SgfReplay() {
+}
+
+int replay_main(int argc, char *argv[]) {
+	if (argc < 1) {
+		printf("usage: GoAI replay <file.sgf>...\n");
+		return 1;
+	}
+	std::atomic<int> next(0);
+	std::atomic<uint64_t> games(0), moves(0), failures(0);
+	std::atomic<int> unreadable(0);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	int threads = std::min<int>(argc, std::max(1u, std::thread::hardware_concurrency()));
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&]() {
+			for (int i = next++; i < argc; i = next++) {
+				MappedFile file;
+				if (!file.open(argv[i])) {
+					fprintf(stderr, "%s: cannot open\n", argv[i]);
+					unreadable++;
+					continue;
+				}
+				SgfReplay replay(nullptr);
+				std::string error;
+				if (!sgf_parse(file.data(), file.data() + file.size(), replay, true,
+						error)) {
+					fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+					unreadable++;
+				}
+				games += replay.get_games();
+				moves += replay.get_moves();
+				failures += replay.get_failures();
+			}
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	printf("%llu games, %llu moves, %llu failed games, %d unreadable files\n",
+			(unsigned long long) games.load(), (unsigned long long) moves.load(),
+			(unsigned long long) failures.load(), unreadable.load());
+	printf("%.2f s, %.0f games/min, %.0f moves/s\n", seconds,
+			games * 60 / seconds, moves / seconds);
+	return (unreadable || failures) ? 1 : 0;
+}
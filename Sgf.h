@@ -0,0 +1,93 @@
+/*
+ * Sgf.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef SGF_H_
+#define SGF_H_
+
+#include "Game.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//callbacks for sgf_parse. names and values point into the parsed text and
+//are only valid until it goes away. values are raw, escapes still in place
+class SgfVisitor {
+public:
+	virtual void game_begin() {
+	}
+	virtual void variation_begin(bool /*main_line*/) {
+	}
+	virtual void node_begin(bool /*main_line*/) {
+	}
+	virtual void property(std::string_view /*name*/,
+			std::string_view /*value*/) {
+	}
+	virtual void node_end() {
+	}
+	virtual void variation_end() {
+	}
+	virtual void game_end() {
+	}
+	virtual ~SgfVisitor();
+};
+
+//walks every game tree in [begin, end) without copying. with main_line_only,
+//side variations are skipped over instead of being reported
+bool sgf_parse(const char *begin, const char *end, SgfVisitor &visitor,
+		bool main_line_only, std::string &error);
+
+std::string sgf_text(std::string_view value); //escapes and soft line breaks removed
+
+//replays the main line of every game into a Game with Game::play_quiet and
+//hands each finished game to the callback
+class SgfReplay: public SgfVisitor {
+public:
+	SgfReplay(std::function<void(Game&)> on_game);
+
+	void game_begin() override;
+	void node_begin(bool main_line) override;
+	void property(std::string_view name, std::string_view value) override;
+	void node_end() override;
+	void game_end() override;
+
+	//called with the position before each recorded move is played
+	void set_move_callback(std::function<void(const Game&, int, bool)> on_move);
+	char get_winner() const; //'B', 'W' or 0 from RE, for the game being replayed
+
+	uint64_t get_games() const;
+	uint64_t get_moves() const;
+	uint64_t get_failures() const; //bad size or a move that couldn't be played
+
+	virtual ~SgfReplay();
+private:
+	struct Pending {
+		char kind; //'B', 'W' for moves, 'b', 'w' for setup stones
+		std::string_view value;
+	};
+	std::function<void(Game&)> on_game;
+	std::function<void(const Game&, int, bool)> on_move;
+	std::unique_ptr<Game> game;
+	std::vector<Pending> pending; //properties of the current node
+	int board_size;
+	double komi;
+	bool failed;
+	bool in_main_line;
+	char winner;
+	uint64_t games;
+	uint64_t moves;
+	uint64_t failures;
+
+	void setup(std::string_view value, bool side);
+};
+
+//"GoAI replay <file>...": replays every game in the files, one thread per file
+int replay_main(int argc, char *argv[]);
+
+#endif /* SGF_H_ */
@@ -0,0 +1,456 @@
+/*
+ * Solver.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Solver.h"
+#include "Symmetry.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static uint64_t peak_memory() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+#ifdef __APPLE__
+	return usage.ru_maxrss; //bytes on macOS
+#else
+	return (uint64_t) usage.ru_maxrss * 1024; //kilobytes on Linux
+#endif
+#endif
+}
+
+Solver::Solver(uint8_t board_size_, int threads_, int max_plies_,
+		uint8_t table_log2) {
+	board_size = board_size_;
+	threads = std::max(1, threads_);
+	max_plies = std::min(max_plies_, 254); //remaining plies go in a byte
+	horizon = max_plies;
+	optimistic = false;
+	for (std::vector<Entry> &table : tables) {
+		table.assign(1ull << table_log2, Entry());
+	}
+	mask = (1ull << table_log2) - 1;
+	nodes = 0;
+}
+
+//a canonical hash is the smallest of 8, so its high bits lean to 0. the
+//filters take the low ones
+static void add_board(std::array<uint64_t, SOLVER_FILTER_WORDS> &filter,
+		uint64_t hash) {
+	filter[(hash >> 6) % SOLVER_FILTER_WORDS] |= 1ull << (hash & 63);
+}
+
+static bool has_board(const std::array<uint64_t, SOLVER_FILTER_WORDS> &filter,
+		uint64_t hash) {
+	return filter[(hash >> 6) % SOLVER_FILTER_WORDS] & (1ull << (hash & 63));
+}
+
+bool Solver::probe(uint64_t key, Entry &out) {
+	std::lock_guard<std::mutex> lock(locks[key & (locks.size() - 1)]);
+	const Entry &entry = tables[optimistic][key & mask];
+	if (!entry.used || entry.key != key) {
+		return false;
+	}
+	out = entry;
+	return true;
+}
+
+void Solver::store(uint64_t key, const Entry &entry) {
+	//a deeper result for the same key is kept
+	std::lock_guard<std::mutex> lock(locks[key & (locks.size() - 1)]);
+	Entry &slot = tables[optimistic][key & mask];
+	if (slot.used && slot.key == key && slot.remaining > entry.remaining) {
+		return;
+	}
+	slot = entry;
+	slot.key = key;
+	slot.used = true;
+}
+
+void Solver::score_bounds(Game &game, int &low, int &high) {
+	//settled points keep their owner, the rest can still go either way
+	std::vector<bool> black = game.benson(true);
+	std::vector<bool> white = game.benson(false);
+	int settled = 0, open = 0;
+	for (int x = 0; x < board_size; x++) {
+		for (int y = 0; y < board_size; y++) {
+			int vertex = game.get_vertex(x, y);
+			if (black[vertex]) {
+				settled++;
+			} else if (white[vertex]) {
+				settled--;
+			} else {
+				open++;
+			}
+		}
+	}
+	low = settled - open;
+	high = settled + open;
+}
+
+void Solver::order_moves(Game &game, int first, std::vector<int> &out) {
+	//the stored best move, then the board, then the pass
+	out.clear();
+	if (first != Board::PASS) {
+		out.push_back(first);
+	}
+	for (int x = 0; x < board_size; x++) {
+		for (int y = 0; y < board_size; y++) {
+			int vertex = game.get_vertex(x, y);
+			if (vertex != first && !game.settled(vertex)
+					&& game.get_board().get_state((uint16_t) vertex) == Board::EMPTY) {
+				out.push_back(vertex);
+			}
+		}
+	}
+	out.push_back(Board::PASS);
+}
+
+int Solver::alphabeta(Game &game, int ply, int alpha, int beta,
+		uint64_t &count, int &depends, std::vector<uint64_t> &path,
+		board_filter &seen) {
+	count++;
+	int symmetry;
+	uint64_t board = game.get_board().get_canonical_hash(&symmetry);
+	add_board(seen, board);
+	if (!game.ongoing()) {
+		return (int) std::lround(game.final_score(0)); //two passes
+	}
+	int low, high;
+	score_bounds(game, low, high);
+	if (low == high) {
+		return low; //no move can change it
+	} else if (low >= beta) {
+		return low;
+	} else if (high <= alpha) {
+		return high;
+	} else if (ply >= horizon) {
+		return optimistic ? high : low;
+	}
+
+	//after a pass the board is the last one on the path already
+	bool placed = !game.passed();
+	size_t earlier = path.size() - (placed ? 0 : 1);
+	uint64_t position = board ^ (game.side() ? 0 : 0xC2B2AE3D27D4EB4Full)
+			^ (game.passed() ? 0x9E3779B97F4A7C15ull : 0);
+	int remaining = horizon - ply;
+	int first = Board::PASS;
+	Entry stored;
+	if (probe(position, stored)) {
+		if (stored.move != Board::PASS) {
+			first = symmetry_table(board_size, inverse_symmetry(symmetry))[stored.move];
+		}
+		//a board from before this node that the stored search went through
+		//could be banned here, and change the result
+		bool clear = stored.remaining >= remaining;
+		for (size_t i = 0; i < earlier && clear; i++) {
+			clear = !has_board(stored.boards, path[i]);
+		}
+		int score = stored.score;
+		if (clear && (stored.bound == TransTable::EXACT
+				|| (stored.bound == TransTable::LOWER && score >= beta)
+				|| (stored.bound == TransTable::UPPER && score <= alpha))) {
+			for (int i = 0; i < SOLVER_FILTER_WORDS; i++) {
+				seen[i] |= stored.boards[i];
+			}
+			return score;
+		}
+	}
+
+	bool maximize = game.side();
+	int best = maximize ? -1000 : 1000;
+	int best_move = Board::PASS;
+	int alpha_in = alpha, beta_in = beta;
+	std::vector<int> moves;
+	order_moves(game, first, moves);
+	int own_depends = INT_MAX;
+	board_filter below = { };
+	add_board(below, board);
+	if (placed) {
+		path.push_back(board);
+	}
+	for (int move : moves) {
+		Game child(game);
+		if (!child.move(move)) {
+			int repeated = game.repeated_board(move);
+			if (repeated >= 0) {
+				own_depends = std::min(own_depends, repeated);
+			}
+			continue;
+		}
+		int score = alphabeta(child, ply + 1, alpha, beta, count, own_depends,
+				path, below);
+		if (maximize ? score > best : score < best) {
+			best = score;
+			best_move = move;
+		}
+		if (maximize) {
+			alpha = std::max(alpha, best);
+		} else {
+			beta = std::min(beta, best);
+		}
+		if (alpha >= beta) {
+			break;
+		}
+	}
+	if (placed) {
+		path.pop_back();
+	}
+	for (int i = 0; i < SOLVER_FILTER_WORDS; i++) {
+		seen[i] |= below[i];
+	}
+
+	//bans of boards from this one on are the same whatever the path here
+	depends = std::min(depends, own_depends);
+	if (own_depends >= game.get_board_index()) {
+		Entry entry;
+		entry.score = (int16_t) best;
+		entry.move = (int16_t) ((best_move == Board::PASS) ?
+				Board::PASS : symmetry_table(board_size, symmetry)[best_move]);
+		entry.remaining = (uint8_t) remaining;
+		entry.bound = TransTable::EXACT;
+		if (best <= alpha_in) {
+			entry.bound = TransTable::UPPER;
+		} else if (best >= beta_in) {
+			entry.bound = TransTable::LOWER;
+		}
+		entry.boards = below;
+		store(position, entry);
+	}
+	return best;
+}
+
+void Solver::search_root(Game &root, std::vector<SolvedMove> &moves, int alpha,
+		int beta) {
+	std::atomic<size_t> next(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&]() {
+			uint64_t count = 0;
+			std::vector<uint64_t> path(1, root.get_board().get_canonical_hash());
+			for (size_t i = next++; i < moves.size(); i = next++) {
+				Game child(root);
+				child.move(moves[i].move);
+				int depends = INT_MAX;
+				board_filter seen = { };
+				int value = alphabeta(child, 1, alpha, beta, count, depends, path,
+						seen);
+				if (!optimistic) {
+					moves[i].lower = value;
+				} else if (value < beta) {
+					//a fail high says nothing about it
+					moves[i].upper = std::min(moves[i].upper, value);
+				}
+			}
+			nodes += count;
+		});
+	}
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+bool Solver::principal_line(Game &line, int value, int first,
+		std::vector<int> &pv, std::vector<uint64_t> &path, uint64_t &count) {
+	//a move that keeps the value both ways, mostly answered by the table. a
+	//dead end steps back and tries the next move
+	if (!line.ongoing()) {
+		return (int) std::lround(line.final_score(0)) == value;
+	}
+	if ((int) pv.size() >= horizon) {
+		return false;
+	}
+	std::vector<int> candidates;
+	line.benson(true);
+	line.benson(false);
+	order_moves(line, first, candidates);
+	bool placed = !line.passed();
+	if (placed) {
+		path.push_back(line.get_board().get_canonical_hash());
+	}
+	bool found = false;
+	for (int move : candidates) {
+		Game child(line);
+		if (!child.move(move)) {
+			continue;
+		}
+		int values[2];
+		for (int mode = 0; mode < 2; mode++) {
+			optimistic = (mode == 1);
+			int depends = INT_MAX;
+			board_filter seen = { };
+			values[mode] = alphabeta(child, pv.size() + 1, value - 1, value + 1,
+					count, depends, path, seen);
+		}
+		if (values[0] != value || values[1] != value) {
+			continue;
+		}
+		pv.push_back(move);
+		if (principal_line(child, value, Board::PASS, pv, path, count)) {
+			found = true;
+			break;
+		}
+		pv.pop_back();
+	}
+	if (placed) {
+		path.pop_back();
+	}
+	return found;
+}
+
+SolveResult Solver::solve() {
+	auto start = std::chrono::steady_clock::now();
+	nodes = 0;
+	SolveResult result;
+	Game root(board_size);
+	root.set_komi(0);
+	int limit = board_size * board_size;
+
+	//one root move per symmetry class of the position it leads to
+	std::vector<SolvedMove> moves;
+	std::vector<uint64_t> seen;
+	std::vector<int> candidates;
+	root.benson(true);
+	root.benson(false);
+	order_moves(root, Board::PASS, candidates);
+	for (int move : candidates) {
+		Game child(root);
+		if (!child.move(move)) {
+			continue;
+		}
+		uint64_t child_key = child.get_board().get_canonical_hash()
+				^ (move == Board::PASS ? 0x9E3779B97F4A7C15ull : 0);
+		if (std::find(seen.begin(), seen.end(), child_key) == seen.end()) {
+			seen.push_back(child_key);
+			moves.push_back( { move, -limit, limit });
+		}
+	}
+
+	//every root move gets the full window in the pessimistic search, so each
+	//lower bound is the best it has. the optimistic one only has to show that
+	//none can beat the best of those, which makes that one exact. both keep
+	//their table between horizons, a deeper result is still a bound
+	int best = -limit;
+	bool met = false;
+	horizon = std::min(2 * limit, max_plies);
+	while (true) {
+		optimistic = false;
+		search_root(root, moves, -limit - 1, limit + 1);
+		best = -limit;
+		for (const SolvedMove &move : moves) {
+			best = std::max(best, move.lower);
+		}
+		optimistic = true;
+		search_root(root, moves, best, best + 1);
+		met = true;
+		for (const SolvedMove &move : moves) {
+			met = met && move.upper <= best;
+		}
+		if (met || horizon >= max_plies) {
+			break;
+		}
+		horizon = std::min(2 * horizon, max_plies);
+	}
+
+	std::stable_sort(moves.begin(), moves.end(),
+			[](const SolvedMove &a, const SolvedMove &b) {
+				return a.lower > b.lower; //black moves first
+			});
+	result.moves = moves;
+	result.value = best;
+	result.upper = best;
+	for (const SolvedMove &move : moves) {
+		result.upper = std::max(result.upper, move.upper);
+	}
+	result.move = moves.empty() ? Board::PASS : moves[0].move;
+	result.complete = met;
+	result.plies = horizon;
+
+	result.pv.clear();
+	uint64_t count = 0;
+	std::vector<uint64_t> path;
+	result.verified = met && !moves.empty()
+			&& principal_line(root, result.value, result.move, result.pv, path,
+					count);
+	nodes += count;
+	result.nodes = nodes;
+	result.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	result.peak_memory = peak_memory();
+	return result;
+}
+
+Solver::~Solver() {
+}
+
+int solve_main(int argc, char *argv[]) {
+	if (argc < 1) {
+		printf("usage: GoAI solve <boardsize> [threads] [max plies, 254 at most]\n");
+		return 1;
+	}
+	int size = std::stoi(argv[0]);
+	if (size < 2 || size > SOLVER_MAX_BOARDSIZE) {
+		printf("the solver handles boards from 2x2 to %dx%d\n",
+				SOLVER_MAX_BOARDSIZE, SOLVER_MAX_BOARDSIZE);
+		return 1;
+	}
+	int threads = (argc > 1) ? std::stoi(argv[1]) :
+								std::max(1u, std::thread::hardware_concurrency());
+	//the horizon starts at twice the points and doubles up to this
+	int max_plies = (argc > 2) ? std::stoi(argv[2]) : 254;
+	Solver solver(size, threads, max_plies);
+	SolveResult result = solver.solve();
+
+	if (!result.complete) {
+		printf("not solved: the value is from %+d to %+d with a horizon of %d plies\n",
+				result.value, result.upper, result.plies);
+		printf("%llu nodes, %.2f s\n", (unsigned long long) result.nodes,
+				result.seconds);
+		return 1;
+	}
+	//moves that lose against the best one only get bounds
+	Game board(size);
+	for (const SolvedMove &move : result.moves) {
+		printf("%-5s %+d", move.move == Board::PASS ?
+				"pass" : board.move_to_text(move.move).c_str(), move.lower);
+		if (move.upper != move.lower) {
+			printf(" to %+d", move.upper);
+		}
+		printf("\n");
+	}
+	printf("value %+d, best %s\npv", result.value, result.move == Board::PASS ?
+			"pass" : board.move_to_text(result.move).c_str());
+	for (int move : result.pv) {
+		printf(" %s", move == Board::PASS ? "pass" : board.move_to_text(move).c_str());
+	}
+	printf("\ncomplete with a horizon of %d plies, %s\n", result.plies,
+			result.verified ? "pv verified" : "pv not verified");
+	printf("%llu nodes, %.2f s, %.0f nodes/s, peak memory %.1f MB\n",
+			(unsigned long long) result.nodes, result.seconds,
+			result.nodes / std::max(result.seconds, 1e-9),
+			result.peak_memory / 1048576.0);
+	return 0;
+}
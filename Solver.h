@@ -0,0 +1,102 @@
+/*
+ * Solver.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include "Game.h"
+#include "TransTable.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#define SOLVER_MAX_BOARDSIZE 5
+#define SOLVER_FILTER_WORDS 64 //4096 bits of boards per table entry
+
+struct SolvedMove {
+	int move; //Board::PASS for a pass
+	int lower; //black minus white with best play after it lies in [lower, upper]
+	int upper;
+};
+
+struct SolveResult {
+	int value; //black minus white, no komi, Tromp-Taylor with positional superko
+	int upper; //value is only a lower bound and this the upper one when not complete
+	int move;
+	std::vector<SolvedMove> moves; //every root move, one per symmetry class
+	std::vector<int> pv;
+	bool complete; //the bounds met, value is exact
+	bool verified; //the pv replays to a finished game worth value
+	int plies; //the last horizon searched
+	uint64_t nodes;
+	double seconds;
+	uint64_t peak_memory; //bytes, 0 when unknown
+};
+
+//exact alpha-beta over whole games on tiny boards, keyed by the canonical
+//hash so the 8 symmetric positions share one entry. nothing is played inside
+//Benson pass-alive areas, and the settled points bound the score of every
+//node: a line at the horizon gets the bound that is worst for black in one
+//search and best in another, so both are sound. the horizon is deepened until
+//they meet. root moves are shared out between threads.
+//under positional superko a result depends on the boards before its node. one
+//that relied on a ban of such a board is not stored, and every entry keeps a
+//filter of the boards its search went through, so it is only used on a path
+//none of whose earlier boards could be among them
+class Solver {
+public:
+	Solver(uint8_t board_size, int threads, int max_plies, uint8_t table_log2 = 16);
+
+	SolveResult solve();
+
+	virtual ~Solver();
+private:
+	typedef std::array<uint64_t, SOLVER_FILTER_WORDS> board_filter;
+	struct Entry {
+		uint64_t key;
+		int16_t score;
+		int16_t move; //in the canonical orientation, Board::PASS when none
+		uint8_t remaining; //plies to the horizon when it was searched
+		TransTable::bound_t bound;
+		bool used;
+		board_filter boards; //canonical hashes of the boards searched under it
+	};
+
+	uint8_t board_size;
+	int threads;
+	int max_plies; //the cap on the horizon
+	int horizon;
+	bool optimistic; //lines cut off at the horizon score best for black
+	std::array<std::vector<Entry>, 2> tables; //pessimistic, optimistic
+	uint64_t mask;
+	std::array<std::mutex, 64> locks; //by slot
+	std::atomic<uint64_t> nodes;
+
+	//depends is lowered to the history index of any earlier board a superko
+	//ban in the search relied on. path holds the canonical hash of every board
+	//on the way here, seen gets those of the boards searched
+	int alphabeta(Game &game, int ply, int alpha, int beta, uint64_t &count,
+			int &depends, std::vector<uint64_t> &path, board_filter &seen);
+	void score_bounds(Game &game, int &low, int &high);
+	void order_moves(Game &game, int first, std::vector<int> &out);
+	bool probe(uint64_t key, Entry &out);
+	void store(uint64_t key, const Entry &entry);
+	//every root move searched with the window, into lower or upper
+	void search_root(Game &root, std::vector<SolvedMove> &moves, int alpha,
+			int beta);
+	//fills pv with a line from line that ends in a finished game worth value
+	bool principal_line(Game &line, int value, int first, std::vector<int> &pv,
+			std::vector<uint64_t> &path, uint64_t &count);
+};
+
+//"GoAI solve <boardsize> [threads] [max plies]", the horizon cap, at most and
+//by default 254
+int solve_main(int argc, char *argv[]);
+
+#endif /* SOLVER_H_ */
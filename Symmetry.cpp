@@ -0,0 +1,84 @@
+/*
+ * Symmetry.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Symmetry.h"
+#include "Board.h"
+#include <vector>
+
+int inverse_symmetry(int symmetry) {
+	//only the quarter turns undo each other, the rest are their own inverse
+	static const int inverses[NUM_SYMMETRIES] = { 0, 3, 2, 1, 4, 5, 6, 7 };
+	return inverses[symmetry];
+}
+
+static void transform(int symmetry, int size, int x, int y, int &out_x,
+		int &out_y) {
+	int last = size - 1;
+	switch (symmetry) {
+	case 0:
+		out_x = x;
+		out_y = y;
+		break;
+	case 1:
+		out_x = y;
+		out_y = last - x;
+		break;
+	case 2:
+		out_x = last - x;
+		out_y = last - y;
+		break;
+	case 3:
+		out_x = last - y;
+		out_y = x;
+		break;
+	case 4:
+		out_x = x;
+		out_y = last - y;
+		break;
+	case 5:
+		out_x = last - x;
+		out_y = y;
+		break;
+	case 6:
+		out_x = y;
+		out_y = x;
+		break;
+	default:
+		out_x = last - y;
+		out_y = last - x;
+	}
+}
+
+const uint16_t* symmetry_tables(uint8_t board_size) {
+	static const std::vector<std::vector<uint16_t>> tables = [] {
+		std::vector<std::vector<uint16_t>> out(MAX_BOARDSIZE + 1);
+		for (int size = 1; size <= MAX_BOARDSIZE; size++) {
+			int stride = size + 2;
+			int area = stride * stride;
+			out[size].resize(NUM_SYMMETRIES * area);
+			for (int s = 0; s < NUM_SYMMETRIES; s++) {
+				uint16_t *table = &out[size][s * area];
+				for (int v = 0; v < area; v++) {
+					table[v] = v;
+				}
+				for (int x = 0; x < size; x++) {
+					for (int y = 0; y < size; y++) {
+						int to_x, to_y;
+						transform(s, size, x, y, to_x, to_y);
+						table[(x + 1) * stride + y + 1] = (to_x + 1) * stride + to_y + 1;
+					}
+				}
+			}
+		}
+		return out;
+	}();
+	return tables[board_size].data();
+}
+
+const uint16_t* symmetry_table(uint8_t board_size, int symmetry) {
+	return symmetry_tables(board_size) + symmetry * (board_size + 2) * (board_size + 2);
+}
@@ -0,0 +1,25 @@
+/*
+ * Symmetry.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef SYMMETRY_H_
+#define SYMMETRY_H_
+
+#include <cstdint>
+
+#define NUM_SYMMETRIES 8
+
+//the 8 rotations and reflections of the board. 0 is the identity, 1-3 turn
+//by 90, 180 and 270 degrees, 4-7 are the reflections
+int inverse_symmetry(int symmetry);
+
+//padded vertex -> padded vertex for one board size, off-board vertices map
+//to themselves. the tables are built once and shared by every thread
+const uint16_t* symmetry_table(uint8_t board_size, int symmetry);
+//all 8 tables of a size back to back, symmetry s starts at s * (size + 2)^2
+const uint16_t* symmetry_tables(uint8_t board_size);
+
+#endif /* SYMMETRY_H_ */
@@ -0,0 +1,90 @@
+/*
+ * TimeControl.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "TimeControl.h"
+#include <algorithm>
+
+#define LAG_SECONDS 0.1 //reply overhead kept back on every move
+#define MIN_MOVES_LEFT 10
+
+TimeControl::TimeControl(double default_seconds_) {
+	default_seconds = default_seconds_;
+	main_time = 0;
+	byo_time = 0;
+	byo_stones = 0;
+	left = { 0, 0 };
+	stones_left = { 0, 0 };
+}
+
+void TimeControl::set(double main_time_, double byo_time_, int byo_stones_) {
+	main_time = main_time_;
+	byo_time = byo_time_;
+	byo_stones = byo_stones_;
+	reset();
+}
+
+void TimeControl::set_left(bool side, double seconds, int stones) {
+	left[side ? 0 : 1] = seconds;
+	stones_left[side ? 0 : 1] = stones;
+}
+
+void TimeControl::spend(bool side, double seconds) {
+	int index = side ? 0 : 1;
+	left[index] -= seconds;
+	if (stones_left[index] > 0) {
+		if (--stones_left[index] == 0) {
+			left[index] = byo_time; //a new byo-yomi period
+			stones_left[index] = byo_stones;
+		}
+	} else if (left[index] <= 0 && byo_stones > 0) {
+		left[index] = byo_time;
+		stones_left[index] = byo_stones;
+	}
+	left[index] = std::max(0.0, left[index]);
+}
+
+void TimeControl::reset() {
+	left = { main_time, main_time };
+	stones_left = { 0, 0 };
+	if (main_time <= 0 && byo_stones > 0) {
+		left = { byo_time, byo_time };
+		stones_left = { byo_stones, byo_stones };
+	}
+}
+
+bool TimeControl::limited() const {
+	//GTP: byo-yomi time > 0 with 0 stones means no limit, main time with
+	//no byo-yomi at all is absolute time
+	if (byo_time > 0 && byo_stones == 0) {
+		return false;
+	}
+	return main_time > 0 || byo_stones > 0;
+}
+
+double TimeControl::budget(bool side, uint8_t board_size, int play_num) const {
+	if (!limited()) {
+		return default_seconds;
+	}
+	int index = side ? 0 : 1;
+	double seconds;
+	if (stones_left[index] > 0) {
+		//in byo-yomi the period is shared evenly by the stones still owed
+		seconds = left[index] / stones_left[index];
+	} else {
+		//games last about half the board in moves per side, never plan for
+		//fewer than MIN_MOVES_LEFT so the end of the game keeps some time
+		int expected = board_size * board_size / 2 - play_num / 2;
+		int moves_left = std::max(MIN_MOVES_LEFT, expected);
+		double period = (byo_stones > 0) ? byo_time / byo_stones : 0;
+		seconds = left[index] / moves_left + 0.5 * period; //byo-yomi is a safety net
+		seconds = std::min(seconds, 0.5 * left[index] + period);
+	}
+	return std::max(0.01, seconds - LAG_SECONDS);
+}
+
+TimeControl::~TimeControl() {
+}
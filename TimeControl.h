@@ -0,0 +1,39 @@
+/*
+ * TimeControl.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef TIMECONTROL_H_
+#define TIMECONTROL_H_
+
+#include <array>
+#include <cstdint>
+
+//canadian byo-yomi clocks as set by GTP time_settings and time_left,
+//and the share of the remaining time a move gets
+class TimeControl {
+public:
+	TimeControl(double default_seconds = 1.0);
+
+	void set(double main_time, double byo_time, int byo_stones);
+	void set_left(bool side, double seconds, int stones); //stones is 0 in main time
+	void spend(bool side, double seconds); //keeps the clock between time_left updates
+	void reset(); //back to the full main time for both sides
+
+	bool limited() const;
+	//seconds to think for side's next move, given how far the game is
+	double budget(bool side, uint8_t board_size, int play_num) const;
+
+	virtual ~TimeControl();
+private:
+	double default_seconds; //per move when there is no clock
+	double main_time;
+	double byo_time;
+	int byo_stones;
+	std::array<double, 2> left; //black, white
+	std::array<int, 2> stones_left; //0 while in main time
+};
+
+#endif /* TIMECONTROL_H_ */
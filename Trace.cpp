@@ -0,0 +1,279 @@
+/*
+ * Trace.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "Trace.h"
+#include "AI.h"
+#include "Json.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+uint64_t trace_now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef GOAI_TRACE
+
+struct TraceEvent {
+	uint64_t start;
+	uint64_t value; //nanoseconds for a scope, the running total for a counter
+	uint16_t name;
+};
+
+//one per recording thread. only the owner writes, every store is a plain
+//relaxed or release store, so recording takes no lock and no locked
+//instruction
+struct TraceThread {
+	int id;
+	uint64_t mask; //capacity - 1
+	std::unique_ptr<TraceEvent[]> events;
+	std::atomic<uint64_t> written; //events ever recorded, the ring holds the last ones
+	std::atomic<uint64_t> calls[TRACE_MAX_NAMES];
+	std::atomic<uint64_t> nanoseconds[TRACE_MAX_NAMES];
+};
+
+static std::mutex trace_mutex; //names and the thread list, never taken while recording
+static const char *names[TRACE_MAX_NAMES] = { "(other)" };
+static bool counters[TRACE_MAX_NAMES];
+static int name_count = 1;
+static std::vector<std::shared_ptr<TraceThread>> threads; //outlive their threads
+static size_t capacity = TRACE_DEFAULT_EVENTS;
+
+static uint16_t register_name(const char *name, bool counter) {
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	for (int i = 1; i < name_count; i++) {
+		if (strcmp(names[i], name) == 0) {
+			return i;
+		}
+	}
+	if (name_count == TRACE_MAX_NAMES) {
+		return 0; //out of names, lumped together
+	}
+	names[name_count] = name;
+	counters[name_count] = counter;
+	return name_count++;
+}
+
+uint16_t trace_name(const char *name) {
+	return register_name(name, false);
+}
+
+uint16_t trace_counter_name(const char *name) {
+	return register_name(name, true);
+}
+
+static TraceThread& trace_thread() {
+	static thread_local std::shared_ptr<TraceThread> thread;
+	if (!thread) {
+		thread = std::make_shared<TraceThread>();
+		std::lock_guard<std::mutex> lock(trace_mutex);
+		thread->id = threads.size();
+		thread->mask = capacity - 1;
+		thread->events.reset(new TraceEvent[capacity]);
+		thread->written = 0;
+		for (int i = 0; i < TRACE_MAX_NAMES; i++) {
+			thread->calls[i] = 0;
+			thread->nanoseconds[i] = 0;
+		}
+		threads.push_back(thread);
+	}
+	return *thread;
+}
+
+static void record(TraceThread &thread, uint16_t name, uint64_t start,
+		uint64_t value) {
+	uint64_t written = thread.written.load(std::memory_order_relaxed);
+	thread.events[written & thread.mask] = { start, value, name };
+	thread.written.store(written + 1, std::memory_order_release);
+}
+
+void trace_event(uint16_t name, uint64_t start, uint64_t end) {
+	TraceThread &thread = trace_thread();
+	record(thread, name, start, end - start);
+	thread.calls[name].store(
+			thread.calls[name].load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed);
+	thread.nanoseconds[name].store(
+			thread.nanoseconds[name].load(std::memory_order_relaxed) + end - start,
+			std::memory_order_relaxed);
+}
+
+void trace_count(uint16_t name, int64_t amount) {
+	TraceThread &thread = trace_thread();
+	uint64_t total = thread.calls[name].load(std::memory_order_relaxed) + amount;
+	thread.calls[name].store(total, std::memory_order_relaxed);
+	record(thread, name, trace_now(), total);
+}
+
+bool trace_compiled() {
+	return true;
+}
+
+void trace_set_capacity(size_t events) {
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	capacity = 1;
+	while (capacity < events) {
+		capacity <<= 1;
+	}
+}
+
+std::vector<TraceTotal> trace_totals() {
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	std::vector<TraceTotal> out;
+	for (int i = 0; i < name_count; i++) {
+		TraceTotal total = { names[i], counters[i], 0, 0 };
+		for (const std::shared_ptr<TraceThread> &thread : threads) {
+			total.calls += thread->calls[i].load(std::memory_order_relaxed);
+			total.seconds += thread->nanoseconds[i].load(std::memory_order_relaxed)
+					* 1e-9;
+		}
+		if (total.calls) {
+			out.push_back(total);
+		}
+	}
+	return out;
+}
+
+bool trace_write_chrome(const std::string &path, std::string &error) {
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	FILE *file = fopen(path.c_str(), "w");
+	if (!file) {
+		error = "cannot write " + path;
+		return false;
+	}
+	//copy every ring first, the earliest event of all is time 0
+	std::vector<std::vector<TraceEvent>> copies;
+	uint64_t origin = UINT64_MAX;
+	for (const std::shared_ptr<TraceThread> &thread : threads) {
+		uint64_t written = thread->written.load(std::memory_order_acquire);
+		uint64_t kept = std::min(written, thread->mask + 1);
+		std::vector<TraceEvent> events;
+		for (uint64_t i = written - kept; i < written; i++) {
+			events.push_back(thread->events[i & thread->mask]);
+			origin = std::min(origin, events.back().start);
+		}
+		copies.push_back(events);
+	}
+	std::vector<std::string> quoted;
+	for (int i = 0; i < name_count; i++) {
+		quoted.push_back(json_quote(names[i]));
+	}
+
+	fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+	const char *separator = "";
+	for (size_t t = 0; t < copies.size(); t++) {
+		fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+				"\"tid\": %zu, \"args\": {\"name\": \"thread %zu\"}}", separator, t, t);
+		separator = ",\n";
+		for (const TraceEvent &event : copies[t]) {
+			double at = (event.start - origin) * 1e-3; //microseconds
+			if (counters[event.name]) {
+				//one series per thread in the same track
+				fprintf(file, ",\n{\"name\": %s, \"ph\": \"C\", \"pid\": 1, "
+						"\"tid\": %zu, \"ts\": %.3f, \"args\": {\"thread %zu\": %lld}}",
+						quoted[event.name].c_str(), t, at, t, (long long) event.value);
+			} else {
+				fprintf(file, ",\n{\"name\": %s, \"ph\": \"X\", \"pid\": 1, "
+						"\"tid\": %zu, \"ts\": %.3f, \"dur\": %.3f}",
+						quoted[event.name].c_str(), t, at, event.value * 1e-3);
+			}
+		}
+	}
+	fprintf(file, "\n]}\n");
+	bool written = !ferror(file);
+	fclose(file);
+	if (!written) {
+		error = "cannot write " + path;
+	}
+	return written;
+}
+
+#else
+
+uint16_t trace_name(const char*) {
+	return 0;
+}
+
+uint16_t trace_counter_name(const char*) {
+	return 0;
+}
+
+void trace_event(uint16_t, uint64_t, uint64_t) {
+}
+
+void trace_count(uint16_t, int64_t) {
+}
+
+bool trace_compiled() {
+	return false;
+}
+
+void trace_set_capacity(size_t) {
+}
+
+std::vector<TraceTotal> trace_totals() {
+	return {};
+}
+
+bool trace_write_chrome(const std::string&, std::string &error) {
+	error = "built without GOAI_TRACE";
+	return false;
+}
+
+#endif
+
+int trace_main(int argc, char *argv[]) {
+	if (argc < 1) {
+		printf("usage: GoAI trace <out.json> [size] [depth] [max moves]\n");
+		return 1;
+	}
+	if (!trace_compiled()) {
+		printf("built without GOAI_TRACE, nothing is recorded\n");
+		return 1;
+	}
+	int size = (argc > 1) ? std::stoi(argv[1]) : 9;
+	SearchLimits limits;
+	limits.depth = (argc > 2) ? std::stoi(argv[2]) : 2;
+	int max_moves = (argc > 3) ? std::stoi(argv[3]) : size * size * 2;
+	if (size < 2 || size > MAX_BOARDSIZE) {
+		printf("unsupported board size %d\n", size);
+		return 1;
+	}
+
+	Game game(size);
+	int moves = 0;
+	while (game.ongoing() && moves < max_moves) {
+		TRACE_SCOPE("genmove");
+		SearchResult result = search(game, limits);
+		game.move((int16_t) result.move);
+		moves++;
+	}
+
+	printf("%d moves\n", moves);
+	for (const TraceTotal &total : trace_totals()) {
+		if (total.counter) {
+			printf("%-20s %12llu\n", total.name.c_str(),
+					(unsigned long long) total.calls);
+		} else {
+			printf("%-20s %12llu calls %10.3f s %10.1f ns/call\n", total.name.c_str(),
+					(unsigned long long) total.calls, total.seconds,
+					total.seconds * 1e9 / total.calls);
+		}
+	}
+	std::string error;
+	if (!trace_write_chrome(argv[0], error)) {
+		printf("%s\n", error.c_str());
+		return 1;
+	}
+	printf("trace written to %s\n", argv[0]);
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Trace.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define TRACE_MAX_NAMES 256 //distinct scope and counter names
+#define TRACE_DEFAULT_EVENTS (1 << 20) //per thread, the oldest are overwritten
+
+//build with -DGOAI_TRACE to record. without it both macros are empty and the
+//instrumented functions compile exactly as they would without them
+#ifdef GOAI_TRACE
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+//times the rest of the enclosing block
+#define TRACE_SCOPE(name) \
+	static const uint16_t TRACE_JOIN(trace_name_, __LINE__) = trace_name(name); \
+	TraceScope TRACE_JOIN(trace_scope_, __LINE__)(TRACE_JOIN(trace_name_, __LINE__))
+//adds amount to a running total, drawn as a counter track
+#define TRACE_COUNT(name, amount) do { \
+		static const uint16_t trace_id = trace_counter_name(name); \
+		trace_count(trace_id, amount); \
+	} while (0)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_COUNT(name, amount)
+#endif
+
+uint16_t trace_name(const char *name); //id of name, the same for every call site using it
+uint16_t trace_counter_name(const char *name);
+uint64_t trace_now(); //steady clock nanoseconds
+void trace_event(uint16_t name, uint64_t start, uint64_t end);
+void trace_count(uint16_t name, int64_t amount);
+
+//the scope of TRACE_SCOPE, inline so a traced call costs two clock reads and
+//a store into the thread's own buffer
+class TraceScope {
+public:
+	TraceScope(uint16_t name_) {
+		name = name_;
+		start = trace_now();
+	}
+	~TraceScope() {
+		trace_event(name, start, trace_now());
+	}
+private:
+	uint16_t name;
+	uint64_t start;
+};
+
+struct TraceTotal {
+	std::string name;
+	bool counter;
+	uint64_t calls; //scopes closed, or for a counter its total
+	double seconds; //inside the scope, summed over threads
+};
+
+bool trace_compiled(); //false unless built with GOAI_TRACE
+//buffer size of threads that have not recorded anything yet, rounded up to a
+//power of two
+void trace_set_capacity(size_t events);
+std::vector<TraceTotal> trace_totals(); //every name seen, over every thread
+
+//chrome trace event JSON, for chrome://tracing or Perfetto: one track per
+//thread with complete events for scopes and counter events for counts. the
+//buffers are read without stopping their writers, so events recorded during
+//the write can replace the oldest ones
+bool trace_write_chrome(const std::string &path, std::string &error);
+
+//"GoAI trace <out.json> [size] [depth] [max moves]": plays a whole game
+//against itself and writes the trace of it
+int trace_main(int argc, char *argv[]);
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,123 @@
+/*
+ * TransTable.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#include "TransTable.h"
+#include <cstring>
+
+//mixed into every check word, so entries written by a build with another
+//eval version fail the key check even in a file both have mapped
+static const uint64_t EVAL_SALT = (uint64_t) TT_EVAL_VERSION
+		* 0x9E3779B97F4A7C15ull;
+
+TransTable::TransTable() {
+	entries = nullptr;
+	mask = 0;
+	probes = 0;
+	hits = 0;
+}
+
+bool TransTable::open(const std::string &path, uint8_t size_log2) {
+	close();
+	static_assert(std::atomic<uint64_t>::is_always_lock_free,
+			"shared entries need lock-free 64-bit atomics");
+	size_t size = sizeof(Header) + (sizeof(Entry) << size_log2);
+	if (!file.open_shared(path, size)) {
+		return false;
+	}
+	if (file.size() != size) {
+		//a bigger table, which another process may still have mapped.
+		//shrinking the file under its mapping would crash it with SIGBUS
+		file.close();
+		return false;
+	}
+	char *data = file.writable_data();
+	Header expected;
+	memset(&expected, 0, sizeof(expected));
+	memcpy(expected.magic, "GOTT", 4);
+	expected.format_version = TT_FORMAT_VERSION;
+	expected.eval_version = TT_EVAL_VERSION;
+	expected.size_log2 = size_log2;
+	if (memcmp(data, &expected, sizeof(expected)) != 0) {
+		//scores from another version can't be trusted, start over. a smaller
+		//file was grown by open_shared, which is safe for its other mappings
+		memset(data, 0, size);
+		memcpy(data, &expected, sizeof(expected));
+	}
+	entries = (Entry*) (data + sizeof(Header));
+	mask = (1ull << size_log2) - 1;
+	return true;
+}
+
+void TransTable::close() {
+	file.close();
+	entries = nullptr;
+	mask = 0;
+}
+
+bool TransTable::is_open() const {
+	return entries != nullptr;
+}
+
+uint64_t TransTable::pack(double score, uint8_t depth, bound_t bound,
+		int move) {
+	//score as a float | depth << 32 | bound << 40 | (move + 1) << 48
+	float value = (float) score;
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits | (uint64_t) depth << 32 | (uint64_t) bound << 40
+			| (uint64_t) (uint16_t) (move + 1) << 48;
+}
+
+bool TransTable::probe(uint64_t key, Result &out) const {
+	if (!entries) {
+		return false;
+	}
+	probes.fetch_add(1, std::memory_order_relaxed);
+	const Entry &entry = entries[key & mask];
+	uint64_t check = entry.check.load(std::memory_order_relaxed);
+	uint64_t data = entry.data.load(std::memory_order_relaxed);
+	if ((check ^ data ^ EVAL_SALT) != key || data == 0) {
+		return false; //another position, an empty slot or a half written entry
+	}
+	hits.fetch_add(1, std::memory_order_relaxed);
+	uint32_t bits = (uint32_t) data;
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	out.score = value;
+	out.depth = (uint8_t) (data >> 32);
+	out.bound = (bound_t) ((data >> 40) & 3);
+	out.move = (int) (uint16_t) (data >> 48) - 1;
+	return true;
+}
+
+void TransTable::store(uint64_t key, double score, uint8_t depth, bound_t bound,
+		int move) {
+	if (!entries) {
+		return;
+	}
+	Entry &entry = entries[key & mask];
+	uint64_t old_data = entry.data.load(std::memory_order_relaxed);
+	uint64_t old_check = entry.check.load(std::memory_order_relaxed);
+	if ((old_check ^ old_data ^ EVAL_SALT) == key
+			&& (uint8_t) (old_data >> 32) > depth) {
+		return; //depth-preferred for the same position, otherwise always replace
+	}
+	uint64_t data = pack(score, depth, bound, move);
+	entry.check.store(key ^ data ^ EVAL_SALT, std::memory_order_relaxed);
+	entry.data.store(data, std::memory_order_relaxed);
+}
+
+uint64_t TransTable::get_probes() const {
+	return probes;
+}
+
+uint64_t TransTable::get_hits() const {
+	return hits;
+}
+
+TransTable::~TransTable() {
+}
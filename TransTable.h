@@ -0,0 +1,80 @@
+/*
+ * TransTable.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: akash
+ */
+
+#ifndef TRANSTABLE_H_
+#define TRANSTABLE_H_
+
+#include "MappedFile.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#define TT_FORMAT_VERSION 2
+//bump whenever a stored score would mean something else: a change to
+//Game::score(), the rules or how minimax searches
+#define TT_EVAL_VERSION 1
+#define TT_DEFAULT_SIZE_LOG2 22 //64 MB
+
+//search results kept in a fixed-size file that several engine processes can
+//map at once. entries are two 64-bit words written without locks, the first
+//being key ^ data ^ a salt from TT_EVAL_VERSION, so a torn entry or one from
+//another eval version fails its key check instead of being misread
+class TransTable {
+public:
+	enum bound_t : uint8_t {
+		EXACT = 0, LOWER = 1, UPPER = 2 //score is a lower or upper bound
+	};
+
+	struct Result {
+		double score; //black's point of view
+		uint8_t depth;
+		bound_t bound;
+		int move; //Board::PASS when none
+	};
+
+	TransTable();
+	TransTable(const TransTable&) = delete;
+	TransTable& operator=(const TransTable&) = delete;
+
+	//maps the file, made or wiped if it has another format, eval version or a
+	//smaller size. fails on a bigger file, it is never shrunk
+	bool open(const std::string &path, uint8_t size_log2);
+	void close();
+	bool is_open() const;
+
+	bool probe(uint64_t key, Result &out) const;
+	//a deeper result for the same key is kept
+	void store(uint64_t key, double score, uint8_t depth, bound_t bound, int move);
+
+	uint64_t get_probes() const;
+	uint64_t get_hits() const;
+
+	virtual ~TransTable();
+private:
+	struct Header {
+		char magic[4]; //"GOTT"
+		uint32_t format_version;
+		uint32_t eval_version;
+		uint32_t size_log2;
+		uint64_t reserved[6]; //keeps the entries on a cache line boundary
+	};
+	struct Entry {
+		std::atomic<uint64_t> check; //key ^ data ^ salt
+		std::atomic<uint64_t> data;
+	};
+	static_assert(sizeof(Entry) == 16, "entries are two plain words in the file");
+
+	MappedFile file;
+	Entry *entries;
+	uint64_t mask;
+	mutable std::atomic<uint64_t> probes;
+	mutable std::atomic<uint64_t> hits;
+
+	static uint64_t pack(double score, uint8_t depth, bound_t bound, int move);
+};
+
+#endif /* TRANSTABLE_H_ */
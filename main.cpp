@@ -1,7 +1,22 @@
 #include "Board.h"
 #include "Game.h"
 #include "AI.h"
+#include "Bench.h"
+#include "GTP.h"
+#include "Analysis.h"
+#include "Book.h"
+#include "Sgf.h"
+#include "SelfPlay.h"
+#include "PositionIndex.h"
+#include "TransTable.h"
+#include "Solver.h"
+#include "LifeDeath.h"
+#include "Pattern.h"
+#include "Perft.h"
+#include "Trace.h"
+#include "Match.h"
 #include <windows.h>
+#include <string>
 
 #include <SFML/Graphics.hpp>
 
@@ -77,7 +92,81 @@ void display(Game g) {
 	}
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "bench") {
+		return bench_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "gtp") {
+		//"GoAI gtp [book] [cache] [patterns] [network] [playouts]", "-" for none.
+		//playouts above 0 pick moves by tree search instead of minimax
+		GTP gtp;
+		if (argc > 2 && std::string(argv[2]) != "-" && !gtp.load_book(argv[2])) {
+			fprintf(stderr, "cannot load book %s\n", argv[2]);
+			return 1;
+		}
+		TransTable cache;
+		if (argc > 3 && std::string(argv[3]) != "-") {
+			if (!cache.open(argv[3], TT_DEFAULT_SIZE_LOG2)) {
+				fprintf(stderr, "cannot open cache %s\n", argv[3]);
+				return 1;
+			}
+			set_transposition_table(&cache);
+		}
+		PatternTable patterns;
+		if (argc > 4 && std::string(argv[4]) != "-") {
+			if (!patterns.load(argv[4])) {
+				fprintf(stderr, "cannot load patterns %s\n", argv[4]);
+				return 1;
+			}
+			set_pattern_table(&patterns);
+		}
+		LoadedNetwork network;
+		bool networked = argc > 5 && std::string(argv[5]) != "-";
+		if (networked && !network.load(argv[5], 16)) {
+			fprintf(stderr, "cannot load network %s\n", argv[5]);
+			return 1;
+		}
+		gtp.set_engine(networked ? &network.get_evaluator() : nullptr,
+				(argc > 6) ? std::stoi(argv[6]) : 0,
+				networked ? network.get_boardsize() : 0);
+		int status = gtp.run(std::cin, std::cout);
+		set_transposition_table(nullptr);
+		set_pattern_table(nullptr);
+		return status;
+	}
+	if (argc > 1 && std::string(argv[1]) == "analyze") {
+		return analyze_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "book") {
+		return book_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "selfplay") {
+		return selfplay_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "index") {
+		return index_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "solve") {
+		return solve_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "tsumego") {
+		return life_death_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "patterns") {
+		return pattern_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "perft") {
+		return perft_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "match") {
+		return match_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "trace") {
+		return trace_main(argc - 2, argv + 2);
+	}
+	if (argc > 1 && std::string(argv[1]) == "replay") {
+		return replay_main(argc - 2, argv + 2);
+	}
 	srand(1);
 	int size = 19;
 	Game x = Game(size);